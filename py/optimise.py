@@ -10,14 +10,15 @@ import pandas as pd
 import numpy as np
 import json
 
-def run_backtest(data_file, threshold, artemis_path):
+def run_backtest(data_file, threshold, artemis_path, env=None):
     """Run backtest with given threshold and parse output."""
     try:
         result = subprocess.run(
             [artemis_path, data_file, str(threshold)],
             capture_output=True,
             text=True,
-            cwd=os.path.dirname(os.path.abspath(__file__))
+            cwd=os.path.dirname(os.path.abspath(__file__)),
+            env=env
         )
         
         if result.returncode != 0:
@@ -47,7 +48,47 @@ def run_backtest(data_file, threshold, artemis_path):
         print(f"Exception running backtest: {e}")
         return None
 
-def grid_search(data_file, artemis_path, threshold_min=1.5, threshold_max=4.0, step=0.1):
+def convert_to_binary(data_file, artemis_path):
+    """Convert CSV data to a .atk binary tick file next to it (cached by mtime)."""
+    if not data_file.endswith('.csv'):
+        return data_file
+    
+    exe = os.path.join(os.path.dirname(artemis_path),
+                       "artemis_convert.exe" if os.name == 'nt' else "artemis_convert")
+    if not os.path.exists(exe):
+        return data_file
+    
+    binary_file = os.path.splitext(data_file)[0] + '.atk'
+    if (os.path.exists(binary_file) and
+            os.path.getmtime(binary_file) >= os.path.getmtime(data_file)):
+        return binary_file
+    
+    result = subprocess.run([exe, data_file, binary_file], capture_output=True, text=True)
+    if result.returncode != 0:
+        print(f"Binary conversion failed, using CSV: {result.stderr}")
+        return data_file
+    
+    print(f"Converted {data_file} -> {binary_file}")
+    return binary_file
+
+def shared_cache_env(data_file):
+    """Environment that lets later artemis runs skip parsing, or None.
+
+    Mids and EWMA state do not depend on the threshold, so they are cached
+    next to the data file when its directory is writable; otherwise decoded
+    ticks are shared through /dev/shm.
+    """
+    env = dict(os.environ)
+    if os.access(os.path.dirname(os.path.abspath(data_file)), os.W_OK):
+        env['ARTEMIS_FEATURE_CACHE'] = '1'
+        return env
+    cache_dir = os.environ.get('ARTEMIS_CACHE_DIR', '/dev/shm')
+    if not os.path.isdir(cache_dir):
+        return None
+    env['ARTEMIS_CACHE'] = 'shm'
+    return env
+
+def grid_search(data_file, artemis_path, threshold_min=1.5, threshold_max=4.0, step=0.1, env=None):
     """Perform grid search over threshold parameter."""
     thresholds = np.arange(threshold_min, threshold_max + step, step)
     results = []
@@ -57,7 +98,7 @@ def grid_search(data_file, artemis_path, threshold_min=1.5, threshold_max=4.0, s
     
     for i, threshold in enumerate(thresholds):
         print(f"\n[{i+1}/{len(thresholds)}] Testing threshold: {threshold:.1f}")
-        result = run_backtest(data_file, threshold, artemis_path)
+        result = run_backtest(data_file, threshold, artemis_path, env)
         if result:
             results.append(result)
             print(f"  Sharpe: {result['sharpe']:.4f}, Max DD: {result['max_dd']:.2f}%")
@@ -109,8 +150,15 @@ def main():
     # Change to project root for relative paths
     os.chdir(project_root)
     
+    # Parse the data once: the first run writes a feature or shared-memory
+    # cache that later runs map read-only. Without either, convert it to
+    # native binary next to the CSV instead.
+    env = shared_cache_env(data_file)
+    if env is None:
+        data_file = convert_to_binary(data_file, artemis_path)
+    
     # Run grid search
-    results = grid_search(data_file, artemis_path, threshold_min=1.5, threshold_max=4.0, step=0.1)
+    results = grid_search(data_file, artemis_path, threshold_min=1.5, threshold_max=4.0, step=0.1, env=env)
     
     if not results:
         print("No results obtained from grid search")
@@ -1,16 +1,22 @@
 #include "Backtester.hpp"
+#include "ContinuousContract.hpp"
+#include "Dataset.hpp"
+#include "FixedRollingStatistics.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
+#include <limits>
+#include <memory>
 
 Backtester::Backtester(double commission, double slippage)
     : commission_(commission),
-      slippage_(slippage * tickSize_),  // Convert ticks to price
+      priceScale_(kTickSize / 2),
+      slippage_(static_cast<PriceTicks>(std::round(slippage * 2))),  // Convert ticks to half ticks
       currentPosition_(Signal::FLAT),
-      entryPrice_(0.0),
+      entryPrice_(0),
       entryTime_(0),
       equity_(100000.0),  // Starting capital
       peakEquity_(100000.0),
@@ -19,8 +25,8 @@ Backtester::Backtester(double commission, double slippage)
     equityTimestamps_.push_back(0);
 }
 
-double Backtester::getFillPrice(double midPrice, Signal direction) const {
-    double fillPrice = midPrice;
+PriceTicks Backtester::getFillPrice(PriceTicks midPrice, Signal direction) const {
+    PriceTicks fillPrice = midPrice;
     
     // Apply slippage: 1 tick against us
     if (direction == Signal::LONG) {
@@ -32,7 +38,7 @@ double Backtester::getFillPrice(double midPrice, Signal direction) const {
     return fillPrice;
 }
 
-void Backtester::updatePosition(double price, int64_t timestamp, Signal signal) {
+void Backtester::updatePosition(PriceTicks price, int64_t timestamp, Signal signal) {
     if (signal == currentPosition_) {
         return;  // No change
     }
@@ -44,7 +50,7 @@ void Backtester::updatePosition(double price, int64_t timestamp, Signal signal)
     
     // Open new position if needed
     if (signal != Signal::FLAT) {
-        double fillPrice = getFillPrice(price, signal);
+        PriceTicks fillPrice = getFillPrice(price, signal);
         currentPosition_ = signal;
         entryPrice_ = fillPrice;
         entryTime_ = timestamp;
@@ -67,20 +73,18 @@ void Backtester::updatePosition(double price, int64_t timestamp, Signal signal)
     }
 }
 
-void Backtester::closePosition(double price, int64_t timestamp) {
+void Backtester::closePosition(PriceTicks price, int64_t timestamp) {
     if (currentPosition_ == Signal::FLAT) {
         return;
     }
     
     Signal exitDirection = (currentPosition_ == Signal::LONG) ? Signal::SHORT : Signal::LONG;
-    double fillPrice = getFillPrice(price, exitDirection);
+    PriceTicks fillPrice = getFillPrice(price, exitDirection);
     
-    double pnl = 0.0;
-    if (currentPosition_ == Signal::LONG) {
-        pnl = (fillPrice - entryPrice_) * 50;  // ES multiplier is 50
-    } else {
-        pnl = (entryPrice_ - fillPrice) * 50;
-    }
+    // Integer move, so PnL is exact ($6.25 per half tick for ES)
+    PriceTicks move = (currentPosition_ == Signal::LONG) ? fillPrice - entryPrice_
+                                                         : entryPrice_ - fillPrice;
+    double pnl = static_cast<double>(move) * priceScale_.tickSize() * kPointValue;
     
     pnl -= commission_;  // Exit commission
     
@@ -89,8 +93,8 @@ void Backtester::closePosition(double price, int64_t timestamp) {
     Trade trade;
     trade.entryTime = entryTime_;
     trade.exitTime = timestamp;
-    trade.entryPrice = entryPrice_;
-    trade.exitPrice = fillPrice;
+    trade.entryPrice = priceScale_.toPrice(entryPrice_);
+    trade.exitPrice = priceScale_.toPrice(fillPrice);
     trade.direction = currentPosition_;
     trade.pnl = pnl;
     trade.duration = timestamp - entryTime_;
@@ -188,14 +192,66 @@ PerformanceMetrics Backtester::calculateMetrics(int64_t startTime, int64_t endTi
 }
 
 PerformanceMetrics Backtester::run(const std::string& dataFile, double threshold) {
-    MarketDataReader reader(dataFile);
-    if (!reader.isValid()) {
-        throw std::runtime_error("Failed to open data file: " + dataFile);
+    return run(dataFile, threshold, std::numeric_limits<int64_t>::min(),
+               std::numeric_limits<int64_t>::max());
+}
+
+PerformanceMetrics Backtester::run(const std::string& dataFile, double threshold,
+                                   int64_t from, int64_t to) {
+    if (ContinuousContract::isRollManifest(dataFile)) {
+        auto series = ContinuousContract::fromManifest(dataFile, from, to, mapOptions_);
+        if (!series->isValid()) {
+            throw std::runtime_error("Failed to open roll manifest: " + dataFile);
+        }
+        return run(*series, threshold);
     }
     
-    RollingStatistics stats(20000);
-    SignalGenerator signalGen(threshold);
+    if (Dataset::isDatasetSpec(dataFile)) {
+        Dataset dataset(Dataset::resolve(dataFile), from, to, mapOptions_);
+        if (!dataset.isValid()) {
+            throw std::runtime_error("Failed to open dataset: " + dataFile);
+        }
+        return run(dataset, threshold);
+    }
+    
+    bool fullRange = from == std::numeric_limits<int64_t>::min() &&
+                     to == std::numeric_limits<int64_t>::max();
+    bool stream = isStreamPath(dataFile);
+    
+    if (useFeatureCache_ && fullRange && !stream && !sessions_) {
+        FeatureCache cache(dataFile, validator_.options());
+        if (cache.isValid()) {
+            // Data quality counts come from when the series was built
+            if (useBars_) {
+                FeatureSeries<Bar> bars = cache.bars(barSpec_);
+                validator_.reset(bars.quality());
+                return run(bars.data(), bars.size(), threshold, barWindow_);
+            }
+            FeatureSeries<MidPoint> mids = cache.mids();
+            validator_.reset(mids.quality());
+            return run(mids, cache.ewma(kWindow, statisticsMode_), threshold, kWindow);
+        }
+    }
+    if (stream || (ioBackend_ != IoBackend::Mmap && fullRange)) {
+        // Pipes cannot seek, so ranges need a regular file
+        if (!fullRange) {
+            throw std::invalid_argument("Time range requires a seekable data file: " + dataFile);
+        }
+        std::unique_ptr<TickSource> source = openTickSource(dataFile, ioBackend_);
+        if (!source->isValid()) {
+            throw std::runtime_error("Failed to open data file: " + dataFile);
+        }
+        return run(*source, threshold);
+    }
     
+    MarketDataReader reader(dataFile, from, to, mapOptions_);
+    if (!reader.isValid()) {
+        throw std::runtime_error("Failed to open data file: " + dataFile);
+    }
+    return run(reader, threshold);
+}
+
+void Backtester::beginRun() {
     trades_.clear();
     equityCurve_.clear();
     equityTimestamps_.clear();
@@ -204,38 +260,177 @@ PerformanceMetrics Backtester::run(const std::string& dataFile, double threshold
     maxDrawdown_ = 0.0;
     currentPosition_ = Signal::FLAT;
     
+    // Entries are added per position change, not per tick: a small
+    // reserve covers typical runs and longer ones grow geometrically
+    equityCurve_.reserve(kInitialReserve);
+    equityTimestamps_.reserve(kInitialReserve);
+    trades_.reserve(kInitialReserve / 2);
+    
     equityCurve_.push_back(equity_);
     equityTimestamps_.push_back(0);
+}
+
+PerformanceMetrics Backtester::run(TickSource& source, double threshold) {
+    validator_.reset();
+    
+    // Session views never span two sessions, so boundaries show up
+    // between batches
+    std::unique_ptr<SessionFilter> filter;
+    if (sessions_) {
+        filter = std::make_unique<SessionFilter>(source, *sessions_);
+    }
+    TickSource& input = filter ? static_cast<TickSource&>(*filter) : source;
+    int64_t session = std::numeric_limits<int64_t>::min();
+    
+    if (useBars_) {
+        BarBuilder builder(barSpec_);
+        std::vector<Bar> bars;
+        Bar last;
+        TickView batch;
+        while (!(batch = input.nextView(kBatchSize)).empty()) {
+            if (filter && filter->sessionClose() != session) {
+                session = filter->sessionClose();
+                if (builder.flush(last)) {
+                    bars.push_back(last);
+                }
+            }
+            builder.add(validator_.apply(batch), bars);
+        }
+        throwIfReadFailed(input, "tick source");
+        if (builder.flush(last)) {
+            bars.push_back(last);
+        }
+        return run(bars, threshold, barWindow_);
+    }
     
-    Tick tick;
-    Tick lastTick;
+    // Window and mode are fixed for the run: pick the compiled-in
+    // statistics once, outside the tick loop
+    return DefaultStatisticsRegistry::dispatch(kWindow, statisticsMode_, [&](auto& stats) {
+        return replay(input, filter.get(), stats, threshold);
+    });
+}
+
+template<typename Stats>
+PerformanceMetrics Backtester::replay(TickSource& input, SessionFilter* filter, Stats& stats, double threshold) {
+    SignalGenerator signalGen(threshold);
+    beginRun();
+    int64_t session = std::numeric_limits<int64_t>::min();
+    
+    Tick lastTick{};
     int64_t startTime = 0;
     int64_t endTime = 0;
     size_t tickCount = 0;
     
-    while (reader.next(tick)) {
+    // Iterate in place: .atk records and .atc blocks are not copied
+    // unless the validator has to drop or repair something
+    TickView batch;
+    while (!(batch = input.nextView(kBatchSize)).empty()) {
+        if (filter && filter->sessionClose() != session) {
+            if (sessionBoundary_ == SessionBoundary::Reset && tickCount > 0) {
+                if (currentPosition_ != Signal::FLAT) {
+                    closePosition(priceScale_.toTicks(lastTick.mid()), lastTick.timestamp);
+                }
+                stats.reset();
+                signalGen.reset();
+            }
+            session = filter->sessionClose();
+        }
+        
+        TickView ticks = validator_.apply(batch);
+        if (ticks.empty()) {
+            continue;
+        }
         if (startTime == 0) {
-            startTime = tick.timestamp;
+            startTime = ticks[0].timestamp;
         }
-        endTime = tick.timestamp;
-        tickCount++;
-        lastTick = tick;  // Keep track of last tick
         
-        double midPrice = tick.mid();
-        stats.update(midPrice);
-        Signal signal = signalGen.generate(midPrice, stats);
+        for (const Tick& tick : ticks) {
+            double midPrice = tick.mid();
+            stats.update(midPrice);
+            Signal signal = signalGen.generate(midPrice, stats);
+            
+            // Prices move to the integer grid only when a trade happens
+            if (signal != currentPosition_) {
+                updatePosition(priceScale_.toTicks(midPrice), tick.timestamp, signal);
+            }
+        }
         
-        updatePosition(midPrice, tick.timestamp, signal);
+        tickCount += ticks.size();
+        lastTick = ticks.back();  // Keep track of last tick
+        endTime = lastTick.timestamp;
     }
     
+    // Truncated input must not pass for a complete run
+    throwIfReadFailed(input, "tick source");
+    
     // Close any open position at the end
     if (currentPosition_ != Signal::FLAT && tickCount > 0) {
-        closePosition(lastTick.mid(), lastTick.timestamp);
+        closePosition(priceScale_.toTicks(lastTick.mid()), lastTick.timestamp);
     }
     
     return calculateMetrics(startTime, endTime, tickCount);
 }
 
+PerformanceMetrics Backtester::run(const Bar* bars, size_t count, double threshold, size_t window) {
+    if (window == 0) {
+        throw std::invalid_argument("Bar window must be positive");
+    }
+    return DefaultStatisticsRegistry::dispatch(window, statisticsMode_, [&](auto& stats) {
+        return replay(bars, count, stats, threshold);
+    });
+}
+
+template<typename Stats>
+PerformanceMetrics Backtester::replay(const Bar* bars, size_t count, Stats& stats, double threshold) {
+    SignalGenerator signalGen(threshold);
+    beginRun();
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Bar& bar = bars[i];
+        stats.update(bar.close);
+        Signal signal = signalGen.generate(bar.close, stats);
+        if (signal != currentPosition_) {
+            updatePosition(priceScale_.toTicks(bar.close), bar.timestamp, signal);
+        }
+    }
+    
+    if (count == 0) {
+        return calculateMetrics(0, 0, 0);
+    }
+    if (currentPosition_ != Signal::FLAT) {
+        closePosition(priceScale_.toTicks(bars[count - 1].close), bars[count - 1].timestamp);
+    }
+    return calculateMetrics(bars[0].timestamp, bars[count - 1].timestamp, count);
+}
+
+PerformanceMetrics Backtester::run(const FeatureSeries<MidPoint>& mids, const FeatureSeries<EwmaPoint>& ewma,
+                                   double threshold, size_t window) {
+    if (ewma.size() != mids.size()) {
+        throw std::invalid_argument("Mid and EWMA series differ in length");
+    }
+    SignalGenerator signalGen(threshold);
+    beginRun();
+    
+    // Before the window fills the signal is FLAT, as with RollingStatistics
+    for (size_t i = window > 0 ? window - 1 : 0; i < mids.size(); ++i) {
+        double mid = mids[i].mid;
+        double sd = std::sqrt(ewma[i].variance);  // As RollingStatistics::zscore
+        Signal signal = signalGen.generateFromZScore(sd > 1e-10 ? (mid - ewma[i].mean) / sd : 0.0);
+        if (signal != currentPosition_) {
+            updatePosition(priceScale_.toTicks(mid), mids[i].timestamp, signal);
+        }
+    }
+    
+    if (mids.empty()) {
+        return calculateMetrics(0, 0, 0);
+    }
+    const MidPoint& last = mids[mids.size() - 1];
+    if (currentPosition_ != Signal::FLAT) {
+        closePosition(priceScale_.toTicks(last.mid), last.timestamp);
+    }
+    return calculateMetrics(mids[0].timestamp, last.timestamp, mids.size());
+}
+
 void Backtester::writeResults(const std::string& filename) const {
     std::ofstream out(filename);
     if (!out.is_open()) {
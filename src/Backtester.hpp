@@ -3,14 +3,20 @@
 #include "MarketDataReader.hpp"
 #include "RollingStatistics.hpp"
 #include "SignalGenerator.hpp"
+#include "Price.hpp"
+#include "TickValidator.hpp"
+#include "BarBuilder.hpp"
+#include "FeatureCache.hpp"
+#include "SessionCalendar.hpp"
 #include <string>
 #include <vector>
 #include <fstream>
+#include <optional>
 
 struct Trade {
     int64_t entryTime;
     int64_t exitTime;
-    double entryPrice;
+    double entryPrice;  // Converted from ticks for reporting
     double exitPrice;
     Signal direction;
     double pnl;
@@ -34,9 +40,30 @@ class Backtester {
 public:
     Backtester(double commission = 2.10, double slippage = 1.0);  // slippage in ticks
     
-    // Run backtest
+    // Run backtest. dataFile may also be a directory, glob or manifest of
+    // files, which are replayed as one stream (see Dataset), or a .roll
+    // manifest of contract files (see ContinuousContract)
     PerformanceMetrics run(const std::string& dataFile, double threshold = 2.5);
     
+    // Run backtest over ticks with from <= timestamp < to (microseconds)
+    PerformanceMetrics run(const std::string& dataFile, double threshold, int64_t from, int64_t to);
+    
+    // Run backtest over any tick source (e.g. a StreamReader on stdin)
+    PerformanceMetrics run(TickSource& source, double threshold = 2.5);
+    
+    // Run backtest on bar closes instead of tick mids, with a z-score
+    // window of `window` bars. totalTicks counts bars.
+    PerformanceMetrics run(const Bar* bars, size_t count, double threshold, size_t window);
+    PerformanceMetrics run(const std::vector<Bar>& bars, double threshold, size_t window) {
+        return run(bars.data(), bars.size(), threshold, window);
+    }
+    
+    // Run backtest on cached mids and the matching EWMA state for a z-score
+    // window of `window` ticks (see FeatureCache); gives the same results as
+    // replaying the ticks
+    PerformanceMetrics run(const FeatureSeries<MidPoint>& mids, const FeatureSeries<EwmaPoint>& ewma,
+                           double threshold, size_t window = kWindow);
+    
     // Get all trades
     const std::vector<Trade>& getTrades() const { return trades_; }
     
@@ -46,27 +73,91 @@ public:
     
     // Write results to CSV
     void writeResults(const std::string& filename) const;
+    
+    // Page-cache hints for the data file mapping
+    void setMapOptions(const MapOptions& options) { mapOptions_ = options; }
+    
+    // Read backend for regular CSV files. Time ranges always use the
+    // mapped reader, which can seek.
+    void setIoBackend(IoBackend backend) { ioBackend_ = backend; }
+    
+    // Data quality policies applied to every tick before it reaches the
+    // strategy (on by default)
+    void setValidation(const ValidationOptions& options) { validator_ = TickValidator(options); }
+    
+    // Counters from the last run
+    const ValidationStats& getValidationStats() const { return validator_.stats(); }
+    
+    // Regular data files: read mids, EWMA state and bars from a cache next
+    // to the file (see FeatureCache), building it on first use. Validation
+    // counters stay zero on cached runs.
+    void setFeatureCache(bool enabled) { useFeatureCache_ = enabled; }
+    
+    // Replay only ticks inside the calendar's sessions; closed hours are
+    // skipped in the reader where it can seek. Bars never span sessions.
+    // Bypasses the feature cache.
+    void setSessions(const SessionCalendar& calendar, SessionBoundary boundary = SessionBoundary::Carry) {
+        sessions_ = calendar;
+        sessionBoundary_ = boundary;
+    }
+    
+    // Rolling z-score statistics: EWMA (default) or an exact sliding window
+    void setStatisticsMode(StatisticsMode mode) { statisticsMode_ = mode; }
+    
+    // Aggregate validated ticks into bars and trade those, for coarse sweeps
+    void setBars(const BarSpec& spec, size_t window) {
+        barSpec_ = spec;
+        barWindow_ = window;
+        useBars_ = true;
+    }
 
+    static constexpr size_t kWindow = 20000;     // Z-score window in ticks
+    
 private:
+    static constexpr double kTickSize = 0.25;    // ES futures tick size
+    static constexpr double kPointValue = 50.0;  // ES multiplier, $ per point
+    
     double commission_;
-    double slippage_;  // in price units (1 tick = 0.25 for ES)
-    const double tickSize_ = 0.25;  // ES futures tick size
+    PriceScale priceScale_;  // Half-tick grid, so every bid/ask mid is exact
+    PriceTicks slippage_;    // in half ticks
+    static constexpr size_t kBatchSize = 1024;  // Ticks per reader call
+    static constexpr size_t kInitialReserve = 1024;  // Equity points reserved per run
+    MapOptions mapOptions_;
+    IoBackend ioBackend_ = IoBackend::Mmap;
+    TickValidator validator_;
+    bool useFeatureCache_ = false;
+    StatisticsMode statisticsMode_ = StatisticsMode::Ewma;
+    std::optional<SessionCalendar> sessions_;
+    SessionBoundary sessionBoundary_ = SessionBoundary::Carry;
+    bool useBars_ = false;
+    BarSpec barSpec_;
+    size_t barWindow_ = 0;
     
     std::vector<Trade> trades_;
     std::vector<double> equityCurve_;
     std::vector<int64_t> equityTimestamps_;
     
     Signal currentPosition_;
-    double entryPrice_;
+    PriceTicks entryPrice_;
     int64_t entryTime_;
     double equity_;
     double peakEquity_;
     double maxDrawdown_;
     
-    // Trade execution
-    double getFillPrice(double midPrice, Signal direction) const;
-    void updatePosition(double price, int64_t timestamp, Signal signal);
-    void closePosition(double price, int64_t timestamp);
+    // Trade execution, prices in half ticks
+    PriceTicks getFillPrice(PriceTicks midPrice, Signal direction) const;
+    void updatePosition(PriceTicks price, int64_t timestamp, Signal signal);
+    void closePosition(PriceTicks price, int64_t timestamp);
+    
+    // Clear results from the previous run
+    void beginRun();
+    
+    // Strategy loops over ticks and bars, for RollingStatistics or a
+    // FixedRollingStatistics picked by DefaultStatisticsRegistry
+    template<typename Stats>
+    PerformanceMetrics replay(TickSource& input, SessionFilter* filter, Stats& stats, double threshold);
+    template<typename Stats>
+    PerformanceMetrics replay(const Bar* bars, size_t count, Stats& stats, double threshold);
     
     // Performance calculation
     PerformanceMetrics calculateMetrics(int64_t startTime, int64_t endTime, size_t tickCount) const;
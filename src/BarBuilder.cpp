@@ -0,0 +1,124 @@
+#include "BarBuilder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Floor division, so ticks before the epoch still bucket correctly
+int64_t floorDiv(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+}  // namespace
+
+BarSpec BarSpec::parse(const std::string& spec) {
+    size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(spec, &used);
+    } catch (const std::exception&) {
+        throw std::invalid_argument("Invalid bar spec: " + spec);
+    }
+    std::string unit = spec.substr(used);
+    
+    BarSpec result;
+    if (unit == "s") {
+        result.size = value * 1e6;
+    } else if (unit == "m") {
+        result.size = value * 60e6;
+    } else if (unit == "h") {
+        result.size = value * 3600e6;
+    } else if (unit == "v") {
+        result.type = BarType::Volume;
+        result.size = value;
+    } else if (unit == "d") {
+        result.type = BarType::Dollar;
+        result.size = value;
+    } else {
+        throw std::invalid_argument("Invalid bar spec: " + spec);
+    }
+    if (!(result.size > 0.0) || (result.type == BarType::Time && result.size < 1.0)) {
+        throw std::invalid_argument("Bar size must be positive: " + spec);
+    }
+    return result;
+}
+
+BarBuilder::BarBuilder(const BarSpec& spec)
+    : spec_(spec),
+      interval_(static_cast<int64_t>(std::llround(spec.size))),
+      current_{},
+      open_(false),
+      bucket_(0),
+      accumulated_(0.0) {
+    if (!(spec.size > 0.0) || (spec.type == BarType::Time && interval_ < 1)) {
+        throw std::invalid_argument("Bar size must be positive");
+    }
+}
+
+size_t BarBuilder::add(const Tick* ticks, size_t count, std::vector<Bar>& out) {
+    size_t emitted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Tick& tick = ticks[i];
+        double mid = tick.mid();
+        
+        if (spec_.type == BarType::Time) {
+            int64_t bucket = floorDiv(tick.timestamp, interval_);
+            if (open_ && bucket != bucket_) {
+                out.push_back(current_);
+                ++emitted;
+                open_ = false;
+            }
+            bucket_ = bucket;
+        }
+        
+        if (!open_) {
+            current_ = Bar{tick.timestamp, mid, mid, mid, mid, 0};
+            open_ = true;
+        } else {
+            current_.timestamp = tick.timestamp;
+            current_.high = std::max(current_.high, mid);
+            current_.low = std::min(current_.low, mid);
+            current_.close = mid;
+        }
+        current_.volume += tick.volume;
+        
+        if (spec_.type != BarType::Time) {
+            accumulated_ += spec_.type == BarType::Volume ? static_cast<double>(tick.volume)
+                                                          : mid * static_cast<double>(tick.volume);
+            if (accumulated_ >= spec_.size) {
+                out.push_back(current_);
+                ++emitted;
+                open_ = false;
+                accumulated_ = 0.0;
+            }
+        }
+    }
+    return emitted;
+}
+
+bool BarBuilder::flush(Bar& bar) {
+    if (!open_) {
+        return false;
+    }
+    bar = current_;
+    open_ = false;
+    accumulated_ = 0.0;
+    return true;
+}
+
+std::vector<Bar> BarBuilder::build(TickSource& source, const BarSpec& spec) {
+    BarBuilder builder(spec);
+    std::vector<Bar> bars;
+    TickView ticks;
+    while (!(ticks = source.nextView(4096)).empty()) {
+        builder.add(ticks, bars);
+    }
+    throwIfReadFailed(source, "tick source");
+    Bar last;
+    if (builder.flush(last)) {
+        bars.push_back(last);
+    }
+    return bars;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Tick.hpp"
+#include "TickSource.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// OHLCV bar over bid/ask mids
+struct Bar {
+    int64_t timestamp;  // Last tick in the bar, when the bar became known
+    double open;
+    double high;
+    double low;
+    double close;
+    int64_t volume;
+};
+
+enum class BarType {
+    Time,    // Fixed clock intervals aligned to the epoch; empty intervals emit nothing
+    Volume,  // Close once traded volume reaches size
+    Dollar   // Close once sum(mid * volume) reaches size
+};
+
+struct BarSpec {
+    BarType type = BarType::Time;
+    double size = 60e6;  // Microseconds, contracts or price * contracts
+    
+    // "30s", "1m", "1h" (time), "5000v" (volume), "2.5e6d" (dollar).
+    // Throws std::invalid_argument for anything else.
+    static BarSpec parse(const std::string& spec);
+};
+
+// Aggregates a tick stream into bars. Ticks are never split: the tick that
+// reaches a volume or dollar threshold closes its bar.
+class BarBuilder {
+public:
+    explicit BarBuilder(const BarSpec& spec);
+    
+    // Feed ticks, appending completed bars to out. Returns bars appended.
+    size_t add(const Tick* ticks, size_t count, std::vector<Bar>& out);
+    size_t add(TickView ticks, std::vector<Bar>& out) { return add(ticks.begin(), ticks.size(), out); }
+    
+    // Close the partial bar, if any. Returns false if none was open.
+    bool flush(Bar& bar);
+    
+    // Every bar of a source, including the final partial one
+    static std::vector<Bar> build(TickSource& source, const BarSpec& spec);
+    
+    const BarSpec& spec() const { return spec_; }
+
+private:
+    BarSpec spec_;
+    int64_t interval_;     // Time bars: size in microseconds
+    Bar current_;
+    bool open_;
+    int64_t bucket_;       // Time bars: interval index of current_
+    double accumulated_;   // Volume/dollar bars: progress towards size
+};
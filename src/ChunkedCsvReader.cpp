@@ -0,0 +1,109 @@
+#include "ChunkedCsvReader.hpp"
+#include "TickParser.hpp"
+#include <cstring>
+
+namespace {
+
+// Last '\n' in [begin, end), or nullptr
+const char* findLastNewline(const char* begin, const char* end) {
+    while (end > begin) {
+        if (*--end == '\n') {
+            return end;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+ChunkedCsvReader::ChunkedCsvReader()
+    : current_(nullptr),
+      cursor_(nullptr),
+      lineEnd_(nullptr),
+      dataEnd_(nullptr),
+      finished_(false),
+      error_(0),
+      dropping_(false) {}
+
+bool ChunkedCsvReader::advance() {
+    if (current_ && current_->eof) {
+        return false;
+    }
+    
+    Chunk* next = acquire();
+    if (!next) {
+        return false;
+    }
+    
+    char* data = next->data;
+    const char* nextEnd = data + next->length;
+    const char* start = data;
+    
+    // Carry the partial line into the headroom before releasing its chunk
+    size_t tailLength = current_ ? static_cast<size_t>(dataEnd_ - lineEnd_) : 0;
+    if (tailLength > kMaxLineLength) {
+        dropping_ = true;
+    } else if (tailLength > 0 && !dropping_) {
+        start = data - tailLength;
+        std::memcpy(data - tailLength, lineEnd_, tailLength);
+    }
+    
+    if (dropping_) {
+        const char* nl = static_cast<const char*>(memchr(data, '\n', next->length));
+        dropping_ = (nl == nullptr);
+        start = nl ? nl + 1 : nextEnd;
+    }
+    
+    if (current_) {
+        release(current_);
+    }
+    
+    current_ = next;
+    error_ = next->error;
+    cursor_ = start;
+    dataEnd_ = nextEnd;
+    if (next->eof) {
+        lineEnd_ = dataEnd_;
+    } else {
+        const char* last = findLastNewline(start, dataEnd_);
+        lineEnd_ = last ? last + 1 : start;
+    }
+    return true;
+}
+
+bool ChunkedCsvReader::refill() {
+    while (cursor_ >= lineEnd_) {
+        if (finished_) {
+            return false;
+        }
+        if (!advance()) {
+            finished_ = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ChunkedCsvReader::next(Tick& tick) {
+    // Header and malformed lines fail to parse and are skipped
+    while (refill()) {
+        bool ok;
+        cursor_ = TickParser::parseNext(cursor_, lineEnd_, tick, ok);
+        if (ok) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ChunkedCsvReader::nextBatch(Tick* out, size_t maxTicks) {
+    size_t n = 0;
+    while (n < maxTicks && refill()) {
+        while (n < maxTicks && cursor_ < lineEnd_) {
+            bool ok;
+            cursor_ = TickParser::parseNext(cursor_, lineEnd_, out[n], ok);
+            n += ok;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "TickSource.hpp"
+#include <cstddef>
+
+// Shared parse loop for the non-mapped CSV backends (StreamReader,
+// UringReader). Subclasses hand over the input as an ordered sequence of
+// chunks; a line split across the chunk edge is carried into headroom
+// reserved in front of the next chunk's data, so every complete line is
+// parsed in place by TickParser.
+class ChunkedCsvReader : public TickSource {
+public:
+    static constexpr size_t kMaxLineLength = 4096;  // Longer lines are dropped as malformed
+
+    using TickSource::nextBatch;
+    bool next(Tick& tick) override;
+    size_t nextBatch(Tick* out, size_t maxTicks) override;
+    int error() const override { return error_; }
+
+protected:
+    struct Chunk {
+        char* data = nullptr;  // kMaxLineLength writable bytes precede this
+        size_t length = 0;
+        bool eof = false;      // Last chunk of the input
+        int error = 0;         // errno if a read failed; implies eof
+    };
+
+    ChunkedCsvReader();
+    ~ChunkedCsvReader() override = default;
+
+    // Next chunk in input order, blocking until it is filled.
+    // nullptr ends the input (e.g. nothing was opened). A read failure is
+    // reported as a last chunk with error set, holding the data read so far.
+    virtual Chunk* acquire() = 0;
+
+    // Chunk fully consumed; its memory may be refilled
+    virtual void release(Chunk* chunk) = 0;
+
+private:
+    Chunk* current_;
+    const char* cursor_;       // Next byte to parse
+    const char* lineEnd_;      // Just past the last complete line
+    const char* dataEnd_;      // End of data in the current chunk
+    bool finished_;
+    int error_;                // From the chunk that ended the input
+    bool dropping_;            // Skipping the rest of an over-long line
+
+    bool advance();            // Switch to the next chunk, carrying the partial line
+    bool refill();             // Make at least one complete line (or the EOF tail) available
+};
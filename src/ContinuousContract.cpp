@@ -0,0 +1,228 @@
+#include "ContinuousContract.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+int64_t sessionOf(int64_t timestamp, int64_t sessionLength) {
+    int64_t q = timestamp / sessionLength;
+    return (timestamp % sessionLength < 0) ? q - 1 : q;
+}
+
+// (session, volume) pairs for ticks in [from, to], in session order
+std::vector<std::pair<int64_t, int64_t>> sessionVolumes(MarketDataReader& reader, int64_t from,
+                                                        int64_t to, int64_t sessionLength) {
+    std::vector<std::pair<int64_t, int64_t>> volumes;
+    if (!reader.seek(from)) {
+        return volumes;
+    }
+    Tick tick;
+    while (reader.next(tick) && tick.timestamp <= to) {
+        int64_t session = sessionOf(tick.timestamp, sessionLength);
+        if (volumes.empty() || volumes.back().first != session) {
+            volumes.emplace_back(session, 0);
+        }
+        volumes.back().second += tick.volume;
+    }
+    return volumes;
+}
+
+}  // namespace
+
+ContinuousContract::ContinuousContract(const std::vector<std::string>& contracts,
+                                       const RollSchedule& schedule, const MapOptions& options)
+    : ContinuousContract(contracts, schedule, std::numeric_limits<int64_t>::min(),
+                         std::numeric_limits<int64_t>::max(), options) {}
+
+ContinuousContract::ContinuousContract(const std::vector<std::string>& contracts,
+                                       const RollSchedule& schedule, int64_t from, int64_t to,
+                                       const MapOptions& options)
+    : contract_(0),
+      valid_(!contracts.empty()) {
+    
+    // Whole-file readers to place the rolls and measure the gaps
+    std::vector<std::unique_ptr<MarketDataReader>> files;
+    for (const std::string& path : contracts) {
+        files.emplace_back(new MarketDataReader(path));
+        valid_ = valid_ && files.back()->isValid();
+    }
+    if (!valid_) {
+        return;
+    }
+    
+    size_t n = contracts.size();
+    if (schedule.method == RollSchedule::Method::FixedDate) {
+        if (schedule.rollTimes.size() != n - 1) {
+            valid_ = false;
+            return;
+        }
+        rollTimes_ = schedule.rollTimes;
+    } else {
+        for (size_t i = 0; i + 1 < n; ++i) {
+            rollTimes_.push_back(volumeCrossover(*files[i], *files[i + 1], schedule.sessionLength));
+        }
+    }
+    for (size_t i = 1; i < rollTimes_.size(); ++i) {
+        rollTimes_[i] = std::max(rollTimes_[i], rollTimes_[i - 1]);  // Never roll backwards
+    }
+    
+    adjustments_.assign(n, 0.0);
+    if (schedule.backAdjust) {
+        for (size_t i = n - 1; i-- > 0;) {
+            double gap = midAt(*files[i + 1], rollTimes_[i]) - midAt(*files[i], rollTimes_[i]);
+            adjustments_[i] = adjustments_[i + 1] + gap;
+        }
+    }
+    
+    for (size_t i = 0; i < n; ++i) {
+        int64_t begin = i == 0 ? std::numeric_limits<int64_t>::min() : rollTimes_[i - 1];
+        int64_t end = i + 1 == n ? std::numeric_limits<int64_t>::max() : rollTimes_[i];
+        readers_.emplace_back(new MarketDataReader(contracts[i], std::max(begin, from),
+                                                   std::min(end, to), options));
+    }
+}
+
+bool ContinuousContract::isRollManifest(const std::string& path) {
+    return std::filesystem::path(path).extension() == ".roll";
+}
+
+std::unique_ptr<ContinuousContract> ContinuousContract::fromManifest(const std::string& path,
+                                                                     int64_t from, int64_t to,
+                                                                     const MapOptions& options) {
+    std::ifstream in(path);
+    std::filesystem::path base = std::filesystem::path(path).parent_path();
+    std::vector<std::string> contracts;
+    RollSchedule schedule;
+    
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string file;
+        if (!(fields >> file)) {
+            continue;
+        }
+        std::filesystem::path contract(file);
+        contracts.push_back(contract.is_absolute() ? contract.string() : (base / contract).string());
+        
+        int64_t rollTime;
+        if (fields >> rollTime) {
+            schedule.rollTimes.push_back(rollTime);
+        }
+    }
+    
+    // Times on some lines but not others leave a mismatched FixedDate
+    // schedule, which the constructor rejects
+    if (!schedule.rollTimes.empty()) {
+        schedule.method = RollSchedule::Method::FixedDate;
+    }
+    return std::unique_ptr<ContinuousContract>(
+        new ContinuousContract(contracts, schedule, from, to, options));
+}
+
+int64_t ContinuousContract::volumeCrossover(MarketDataReader& front, MarketDataReader& next,
+                                            int64_t sessionLength) {
+    int64_t frontFirst, frontLast, nextFirst, nextLast;
+    if (!front.timeBounds(frontFirst, frontLast)) {
+        return std::numeric_limits<int64_t>::min();  // Nothing to replay from front
+    }
+    if (!next.timeBounds(nextFirst, nextLast)) {
+        return std::numeric_limits<int64_t>::max();
+    }
+    
+    int64_t start = std::max(frontFirst, nextFirst);
+    int64_t end = std::min(frontLast, nextLast);
+    if (start <= end) {
+        auto frontVolumes = sessionVolumes(front, start, end, sessionLength);
+        auto nextVolumes = sessionVolumes(next, start, end, sessionLength);
+        
+        // Walk both session lists in step; a session missing from one side
+        // counts as zero volume there
+        size_t f = 0;
+        for (const auto& session : nextVolumes) {
+            while (f < frontVolumes.size() && frontVolumes[f].first < session.first) {
+                ++f;
+            }
+            int64_t frontVolume = (f < frontVolumes.size() && frontVolumes[f].first == session.first)
+                                      ? frontVolumes[f].second : 0;
+            if (session.second > frontVolume) {
+                return (session.first + 1) * sessionLength;
+            }
+        }
+    }
+    
+    // No crossover: stay on front until it stops trading
+    return std::max(frontLast + 1, nextFirst);
+}
+
+double ContinuousContract::midAt(MarketDataReader& reader, int64_t timestamp) {
+    // First tick at or after the roll, else the contract's last tick
+    int64_t first, last;
+    if (!reader.timeBounds(first, last)) {
+        return 0.0;
+    }
+    Tick tick;
+    if (!reader.seek(std::min(timestamp, last)) || !reader.next(tick)) {
+        return 0.0;
+    }
+    return tick.mid();
+}
+
+bool ContinuousContract::next(Tick& tick) {
+    return nextBatch(&tick, 1) == 1;
+}
+
+size_t ContinuousContract::nextBatch(Tick* out, size_t maxTicks) {
+    size_t n = 0;
+    while (n < maxTicks && contract_ < readers_.size()) {
+        size_t got = readers_[contract_]->nextBatch(out + n, maxTicks - n);
+        if (got == 0) {
+            ++contract_;
+            continue;
+        }
+        
+        double adjustment = adjustments_[contract_];
+        if (adjustment != 0.0) {
+            for (size_t i = n; i < n + got; ++i) {
+                out[i].bid += adjustment;
+                out[i].ask += adjustment;
+            }
+        }
+        n += got;
+    }
+    return n;
+}
+
+TickView ContinuousContract::nextView(size_t maxTicks) {
+    while (contract_ < readers_.size()) {
+        if (adjustments_[contract_] != 0.0) {
+            return TickSource::nextView(maxTicks);  // Adjusted copy
+        }
+        TickView view = readers_[contract_]->nextView(maxTicks);
+        if (!view.empty()) {
+            return view;
+        }
+        ++contract_;
+    }
+    return TickView{};
+}
+
+size_t ContinuousContract::tickCount() const {
+    size_t total = 0;
+    for (const auto& reader : readers_) {
+        total += reader->tickCount();
+    }
+    return total;
+}
+
+int ContinuousContract::error() const {
+    for (const auto& reader : readers_) {
+        if (int err = reader->error()) {
+            return err;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "MarketDataReader.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// When to hand over from one contract to the next
+struct RollSchedule {
+    enum class Method {
+        VolumeCrossover,  // First session in which the next contract trades more volume
+        FixedDate         // Explicit handover times
+    };
+    
+    Method method = Method::VolumeCrossover;
+    std::vector<int64_t> rollTimes;  // FixedDate: contracts.size() - 1 times (microseconds)
+    int64_t sessionLength = 86400000000LL;  // VolumeCrossover bucket, UTC days by default
+    bool backAdjust = true;          // Shift earlier contracts by the roll gaps
+};
+
+// Front-month continuous series stitched from per-contract files (e.g.
+// ESH4, ESM4, ESU4, ... in expiry order) and replayed as one stream, so
+// the strategy's rolling statistics stay warm across every roll.
+//
+// Contract i is replayed over [roll[i-1], roll[i]). With back-adjustment
+// (Panama method) each roll gap, the next contract's mid minus the
+// expiring one's at the roll time, is added to the bid/ask of every
+// earlier contract while streaming; the latest contract is unadjusted.
+class ContinuousContract final : public TickSource {
+public:
+    ContinuousContract(const std::vector<std::string>& contracts,
+                       const RollSchedule& schedule = RollSchedule(),
+                       const MapOptions& options = MapOptions());
+    
+    // Replay only ticks with from <= timestamp < to. Rolls and adjustments
+    // are still computed over the whole files.
+    ContinuousContract(const std::vector<std::string>& contracts, const RollSchedule& schedule,
+                       int64_t from, int64_t to, const MapOptions& options = MapOptions());
+    
+    // Roll manifest (.roll): one contract file per line in expiry order,
+    // optionally followed by the time it rolls into the next line's
+    // contract. Without times, rolls are found by volume crossover.
+    // Paths are relative to the manifest's directory, '#' starts a comment.
+    static std::unique_ptr<ContinuousContract> fromManifest(
+        const std::string& path, int64_t from = std::numeric_limits<int64_t>::min(),
+        int64_t to = std::numeric_limits<int64_t>::max(), const MapOptions& options = MapOptions());
+    static bool isRollManifest(const std::string& path);
+    
+    using TickSource::nextBatch;
+    bool next(Tick& tick) override;
+    size_t nextBatch(Tick* out, size_t maxTicks) override;
+    
+    // Unadjusted contracts (the latest one) pass their reader's view through
+    TickView nextView(size_t maxTicks) override;
+    
+    // Sum of the contract files' tickCount(): an upper bound
+    size_t tickCount() const override;
+    
+    bool isValid() const override { return valid_; }
+    
+    // First read error among the contract files
+    int error() const override;
+    
+    // Handover times (contracts - 1) and per-contract price offsets
+    const std::vector<int64_t>& rollTimes() const { return rollTimes_; }
+    const std::vector<double>& adjustments() const { return adjustments_; }
+    
+    // Session in which `next` first out-trades `front`; returns the start of
+    // the following session (the crossover is only known once the session
+    // ends), or the first tick after `front` stops trading if it never happens
+    static int64_t volumeCrossover(MarketDataReader& front, MarketDataReader& next,
+                                   int64_t sessionLength);
+
+private:
+    std::vector<int64_t> rollTimes_;
+    std::vector<double> adjustments_;
+    std::vector<std::unique_ptr<MarketDataReader>> readers_;  // Ranged to each contract's span
+    size_t contract_;
+    bool valid_;
+    
+    static double midAt(MarketDataReader& reader, int64_t timestamp);
+};
@@ -0,0 +1,253 @@
+#include "Dataset.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using HeapEntry = std::pair<int64_t, size_t>;
+using HeapOrder = std::greater<HeapEntry>;  // Min-heap on (timestamp, source)
+
+bool isTickDataFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    return ext == ".csv" || ext == ".atk" || ext == ".atc";
+}
+
+bool isManifest(const std::string& path) {
+    std::string ext = fs::path(path).extension().string();
+    return ext == ".txt" || ext == ".manifest";
+}
+
+bool hasWildcard(const std::string& path) {
+    return path.find_first_of("*?") != std::string::npos;
+}
+
+// '*' and '?' matching on a single path component
+bool wildcardMatch(const char* pattern, const char* name) {
+    const char* star = nullptr;
+    const char* retry = nullptr;
+    while (*name) {
+        if (*pattern == '?' || *pattern == *name) {
+            ++pattern;
+            ++name;
+        } else if (*pattern == '*') {
+            star = pattern++;
+            retry = name;
+        } else if (star) {
+            pattern = star + 1;
+            name = ++retry;
+        } else {
+            return false;
+        }
+    }
+    while (*pattern == '*') {
+        ++pattern;
+    }
+    return *pattern == '\0';
+}
+
+}  // namespace
+
+Dataset::Dataset(const std::string& spec, const MapOptions& options)
+    : Dataset(resolve(spec), options) {}
+
+Dataset::Dataset(const std::vector<std::string>& files, const MapOptions& options)
+    : Dataset(files, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), options) {}
+
+Dataset::Dataset(const std::vector<std::string>& files, int64_t from, int64_t to,
+                 const MapOptions& options)
+    : segment_(0),
+      primed_(false),
+      valid_(!files.empty()) {
+    open(files, from, to, options);
+}
+
+bool Dataset::isDatasetSpec(const std::string& path) {
+    std::error_code ec;
+    return fs::is_directory(path, ec) || hasWildcard(path) || isManifest(path);
+}
+
+std::vector<std::string> Dataset::resolve(const std::string& spec) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    
+    if (fs::is_directory(spec, ec)) {
+        for (const auto& entry : fs::directory_iterator(spec, ec)) {
+            if (entry.is_regular_file(ec) && isTickDataFile(entry.path())) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else if (hasWildcard(spec)) {
+        fs::path path(spec);
+        fs::path dir = path.has_parent_path() ? path.parent_path() : fs::path(".");
+        std::string pattern = path.filename().string();
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            if (entry.is_regular_file(ec) &&
+                wildcardMatch(pattern.c_str(), entry.path().filename().string().c_str())) {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    } else if (isManifest(spec)) {
+        std::ifstream in(spec);
+        fs::path base = fs::path(spec).parent_path();
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t b = line.find_first_not_of(" \t\r");
+            size_t e = line.find_last_not_of(" \t\r");
+            if (b == std::string::npos || line[b] == '#') {
+                continue;
+            }
+            fs::path file(line.substr(b, e - b + 1));
+            files.push_back(file.is_absolute() ? file.string() : (base / file).string());
+        }
+    } else {
+        files.push_back(spec);
+    }
+    return files;
+}
+
+void Dataset::open(const std::vector<std::string>& files, int64_t from, int64_t to,
+                   const MapOptions& options) {
+    for (const std::string& path : files) {
+        Source source;
+        source.reader.reset(new MarketDataReader(path, from, to, options));
+        if (!source.reader->isValid()) {
+            valid_ = false;
+            continue;
+        }
+        // Empty files and files outside the window drop out here
+        if (!source.reader->timeBounds(source.first, source.last) ||
+            source.last < from || source.first >= to) {
+            continue;
+        }
+        sources_.push_back(std::move(source));
+    }
+    
+    std::stable_sort(sources_.begin(), sources_.end(),
+                     [](const Source& a, const Source& b) { return a.first < b.first; });
+    
+    // Split into runs of overlapping files; a file starting at or after
+    // everything before it ends can simply be concatenated
+    size_t begin = 0;
+    int64_t segmentLast = 0;
+    for (size_t i = 0; i < sources_.size(); ++i) {
+        if (i > 0 && sources_[i].first >= segmentLast) {
+            segments_.push_back({begin, i});
+            begin = i;
+        }
+        segmentLast = (i == begin) ? sources_[i].last : std::max(segmentLast, sources_[i].last);
+    }
+    if (!sources_.empty()) {
+        segments_.push_back({begin, sources_.size()});
+    }
+    
+    for (const Segment& segment : segments_) {
+        if (segment.end - segment.begin > 1) {
+            for (size_t i = segment.begin; i < segment.end; ++i) {
+                sources_[i].buffer.resize(kMergeBufferSize);
+            }
+        }
+    }
+}
+
+bool Dataset::fill(Source& source) {
+    source.pos = 0;
+    source.count = source.reader->nextBatch(source.buffer.data(), source.buffer.size());
+    return source.count > 0;
+}
+
+size_t Dataset::merge(Tick* out, size_t maxTicks) {
+    const Segment& segment = segments_[segment_];
+    if (!primed_) {
+        heap_.clear();
+        for (size_t i = segment.begin; i < segment.end; ++i) {
+            if (fill(sources_[i])) {
+                heap_.emplace_back(sources_[i].buffer[0].timestamp, i);
+            }
+        }
+        std::make_heap(heap_.begin(), heap_.end(), HeapOrder());
+        primed_ = true;
+    }
+    
+    size_t n = 0;
+    while (n < maxTicks && !heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), HeapOrder());
+        size_t i = heap_.back().second;
+        heap_.pop_back();
+        Source& source = sources_[i];
+        
+        // Copy a run from this file until another file's head comes first
+        do {
+            out[n++] = source.buffer[source.pos++];
+            if (source.pos == source.count && !fill(source)) {
+                break;
+            }
+        } while (n < maxTicks &&
+                 (heap_.empty() || HeapEntry(source.buffer[source.pos].timestamp, i) < heap_.front()));
+        
+        if (source.pos < source.count) {
+            heap_.emplace_back(source.buffer[source.pos].timestamp, i);
+            std::push_heap(heap_.begin(), heap_.end(), HeapOrder());
+        }
+    }
+    return n;
+}
+
+bool Dataset::next(Tick& tick) {
+    return nextBatch(&tick, 1) == 1;
+}
+
+size_t Dataset::nextBatch(Tick* out, size_t maxTicks) {
+    size_t n = 0;
+    while (n < maxTicks && segment_ < segments_.size()) {
+        const Segment& segment = segments_[segment_];
+        size_t got = segment.end - segment.begin == 1
+                         ? sources_[segment.begin].reader->nextBatch(out + n, maxTicks - n)
+                         : merge(out + n, maxTicks - n);
+        if (got == 0) {
+            ++segment_;
+            primed_ = false;
+        }
+        n += got;
+    }
+    return n;
+}
+
+TickView Dataset::nextView(size_t maxTicks) {
+    while (segment_ < segments_.size()) {
+        const Segment& segment = segments_[segment_];
+        if (segment.end - segment.begin > 1) {
+            return TickSource::nextView(maxTicks);  // Merged into the view buffer
+        }
+        TickView view = sources_[segment.begin].reader->nextView(maxTicks);
+        if (!view.empty()) {
+            return view;
+        }
+        ++segment_;
+        primed_ = false;
+    }
+    return TickView{};
+}
+
+size_t Dataset::tickCount() const {
+    size_t total = 0;
+    for (const Source& source : sources_) {
+        total += source.reader->tickCount();
+    }
+    return total;
+}
+
+int Dataset::error() const {
+    for (const Source& source : sources_) {
+        if (int err = source.reader->error()) {
+            return err;
+        }
+    }
+    return 0;
+}
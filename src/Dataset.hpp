@@ -0,0 +1,88 @@
+#pragma once
+
+#include "MarketDataReader.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Many tick files (one per session and/or contract) replayed as a single
+// timestamp-ordered stream, so a year of sessions runs in one process with
+// one warmup.
+//
+// Files are ordered by their first timestamp and split into segments:
+// files whose time spans overlap (e.g. several instruments on the same day)
+// form one segment that is k-way merged through a min-heap; a file that
+// overlaps nothing (consecutive days) is a segment of its own and is read
+// straight into the caller's buffer. Ties go to the file that starts first.
+class Dataset final : public TickSource {
+public:
+    // spec: a directory (all .csv/.atk/.atc files in it), a glob on the
+    // file name ("data/ES_2024-*.atk") or a manifest (.txt/.manifest, one
+    // path per line, '#' comments, relative to the manifest's directory)
+    explicit Dataset(const std::string& spec, const MapOptions& options = MapOptions());
+    
+    explicit Dataset(const std::vector<std::string>& files, const MapOptions& options = MapOptions());
+    
+    // Replay only ticks with from <= timestamp < to; files entirely
+    // outside the window are not read at all
+    Dataset(const std::vector<std::string>& files, int64_t from, int64_t to,
+            const MapOptions& options = MapOptions());
+    
+    // True if path names a directory, glob or manifest rather than one file
+    static bool isDatasetSpec(const std::string& path);
+    
+    // Expand a spec into file paths (sorted for directories and globs,
+    // listed order for manifests). Empty if nothing matches.
+    static std::vector<std::string> resolve(const std::string& spec);
+    
+    using TickSource::nextBatch;
+    bool next(Tick& tick) override;
+    size_t nextBatch(Tick* out, size_t maxTicks) override;
+    
+    // Disjoint files pass their reader's view through uncopied
+    TickView nextView(size_t maxTicks) override;
+    
+    // Sum of the files' tickCount(): an upper bound on the ticks replayed
+    size_t tickCount() const override;
+    
+    // False if the dataset is empty or any file failed to open
+    bool isValid() const override { return valid_; }
+    
+    // First read error among the files
+    int error() const override;
+    
+    // Files that take part in the replay, and the segments they form
+    size_t fileCount() const { return sources_.size(); }
+    size_t segmentCount() const { return segments_.size(); }
+
+private:
+    static constexpr size_t kMergeBufferSize = 256;  // Ticks buffered per merged file
+    
+    struct Source {
+        std::unique_ptr<MarketDataReader> reader;
+        int64_t first = 0;
+        int64_t last = 0;
+        std::vector<Tick> buffer;  // Merged segments only
+        size_t pos = 0;
+        size_t count = 0;
+    };
+    
+    struct Segment {
+        size_t begin;  // Range of sources_
+        size_t end;
+    };
+    
+    std::vector<Source> sources_;
+    std::vector<Segment> segments_;
+    size_t segment_;
+    bool primed_;  // Heap holds the current merged segment's heads
+    std::vector<std::pair<int64_t, size_t>> heap_;  // (timestamp, source) min-heap
+    bool valid_;
+    
+    void open(const std::vector<std::string>& files, int64_t from, int64_t to,
+              const MapOptions& options);
+    bool fill(Source& source);
+    size_t merge(Tick* out, size_t maxTicks);
+};
@@ -0,0 +1,121 @@
+#include "EwmaBank.hpp"
+#include <algorithm>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t kLanes = 4;
+
+}  // namespace
+
+EwmaBank::EwmaBank(const std::vector<size_t>& windows)
+    : windows_(windows),
+      maxWindow_(0),
+      count_(0) {
+    if (windows.empty()) {
+        throw std::invalid_argument("EwmaBank needs at least one window");
+    }
+    
+    // Padding lanes run a dummy window and are never read
+    size_t lanes = (windows.size() + kLanes - 1) / kLanes * kLanes;
+    alpha_.assign(lanes, 1.0);
+    decay_.assign(lanes, 0.0);
+    limit_.assign(lanes, 1.0);
+    for (size_t i = 0; i < windows.size(); ++i) {
+        if (windows[i] == 0) {
+            throw std::invalid_argument("EwmaBank window must be positive");
+        }
+        alpha_[i] = 2.0 / (windows[i] + 1.0);  // As RollingStatistics
+        decay_[i] = 1.0 - alpha_[i];
+        limit_[i] = static_cast<double>(windows[i]);
+        maxWindow_ = std::max(maxWindow_, windows[i]);
+    }
+    mean_.assign(lanes, 0.0);
+    variance_.assign(lanes, 0.0);
+    m2_.assign(lanes, 0.0);
+}
+
+void EwmaBank::reset() {
+    count_ = 0;
+    std::fill(mean_.begin(), mean_.end(), 0.0);
+    std::fill(variance_.begin(), variance_.end(), 0.0);
+    std::fill(m2_.begin(), m2_.end(), 0.0);
+}
+
+void EwmaBank::update(double value) {
+    size_t oldCount = count_++;
+    size_t lanes = mean_.size();
+    
+    if (oldCount == 0) {
+        std::fill(mean_.begin(), mean_.end(), value);
+        std::fill(variance_.begin(), variance_.end(), 0.0);
+        std::fill(m2_.begin(), m2_.end(), 0.0);
+        return;
+    }
+    
+    // Each lane takes the Welford step while oldCount < window, else the
+    // EWMA step. Both are computed and blended, so there is no branch per
+    // horizon.
+    double n = static_cast<double>(oldCount + 1);
+    double filled = static_cast<double>(oldCount);
+    size_t i = 0;
+    
+#if defined(__AVX2__)
+    const __m256d x = _mm256_set1_pd(value);
+    const __m256d nv = _mm256_set1_pd(n);
+    const __m256d filledv = _mm256_set1_pd(filled);
+    const __m256d zero = _mm256_setzero_pd();
+    if (oldCount >= maxWindow_) {
+        // Every horizon warm: EWMA only, no divisions
+        for (; i + kLanes <= lanes; i += kLanes) {
+            __m256d mean = _mm256_loadu_pd(&mean_[i]);
+            __m256d alpha = _mm256_loadu_pd(&alpha_[i]);
+            __m256d decay = _mm256_loadu_pd(&decay_[i]);
+            __m256d delta = _mm256_sub_pd(x, mean);
+            __m256d variance = _mm256_add_pd(_mm256_loadu_pd(&variance_[i]),
+                                             _mm256_mul_pd(_mm256_mul_pd(alpha, delta), delta));
+            _mm256_storeu_pd(&mean_[i], _mm256_add_pd(_mm256_mul_pd(alpha, x), _mm256_mul_pd(decay, mean)));
+            _mm256_storeu_pd(&variance_[i], _mm256_max_pd(_mm256_mul_pd(decay, variance), zero));
+        }
+    }
+    for (; i + kLanes <= lanes; i += kLanes) {
+        __m256d mean = _mm256_loadu_pd(&mean_[i]);
+        __m256d variance = _mm256_loadu_pd(&variance_[i]);
+        __m256d m2 = _mm256_loadu_pd(&m2_[i]);
+        __m256d alpha = _mm256_loadu_pd(&alpha_[i]);
+        __m256d decay = _mm256_loadu_pd(&decay_[i]);
+        __m256d warming = _mm256_cmp_pd(filledv, _mm256_loadu_pd(&limit_[i]), _CMP_LT_OQ);
+    
+        __m256d delta = _mm256_sub_pd(x, mean);
+    
+        // Welford
+        __m256d welfordMean = _mm256_add_pd(mean, _mm256_div_pd(delta, nv));
+        __m256d welfordM2 = _mm256_add_pd(m2, _mm256_mul_pd(delta, _mm256_sub_pd(x, welfordMean)));
+        __m256d welfordVar = _mm256_div_pd(welfordM2, nv);
+    
+        // EWMA
+        __m256d ewmaMean = _mm256_add_pd(_mm256_mul_pd(alpha, x), _mm256_mul_pd(decay, mean));
+        __m256d ewmaVar = _mm256_mul_pd(decay, _mm256_add_pd(variance,
+                                        _mm256_mul_pd(_mm256_mul_pd(alpha, delta), delta)));
+        ewmaVar = _mm256_max_pd(ewmaVar, zero);
+    
+        _mm256_storeu_pd(&mean_[i], _mm256_blendv_pd(ewmaMean, welfordMean, warming));
+        _mm256_storeu_pd(&variance_[i], _mm256_blendv_pd(ewmaVar, welfordVar, warming));
+        _mm256_storeu_pd(&m2_[i], _mm256_blendv_pd(m2, welfordM2, warming));
+    }
+#endif
+    for (; i < lanes; ++i) {
+        double delta = value - mean_[i];
+        if (filled < limit_[i]) {
+            mean_[i] += delta / n;
+            m2_[i] += delta * (value - mean_[i]);
+            variance_[i] = m2_[i] / n;
+        } else {
+            mean_[i] = alpha_[i] * value + decay_[i] * mean_[i];
+            variance_[i] = std::max(0.0, decay_[i] * (variance_[i] + alpha_[i] * delta * delta));
+        }
+    }
+}
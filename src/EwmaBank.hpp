@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// EWMA mean/variance at several windows over the same input, e.g. one
+// mean-reversion signal at several decay horizons. Each horizon follows
+// RollingStatistics(window) in EWMA mode: Welford until its window fills,
+// then the EWMA update. State is kept as structure-of-arrays and every
+// update runs all horizons in one AVX2 pass (four per vector), so eight
+// horizons cost about what one RollingStatistics does.
+class EwmaBank {
+public:
+    // Throws std::invalid_argument if windows is empty or holds a zero
+    explicit EwmaBank(const std::vector<size_t>& windows);
+    
+    // Feed one value to every horizon
+    void update(double value);
+    
+    // Forget all values, as if newly constructed
+    void reset();
+    
+    // Number of horizons, in constructor order
+    size_t size() const { return windows_.size(); }
+    size_t window(size_t i) const { return windows_[i]; }
+    
+    double mean(size_t i) const { return mean_[i]; }
+    double variance(size_t i) const { return variance_[i]; }
+    double stddev(size_t i) const { return std::sqrt(variance_[i]); }
+    double zscore(size_t i, double value) const {
+        double sd = stddev(i);
+        return sd > 1e-10 ? (value - mean_[i]) / sd : 0.0;
+    }
+    
+    // Contiguous means/variances of all horizons
+    const double* means() const { return mean_.data(); }
+    const double* variances() const { return variance_.data(); }
+    
+    size_t count() const { return count_; }
+    bool isReady(size_t i) const { return count_ >= windows_[i]; }
+    
+private:
+    std::vector<size_t> windows_;
+    
+    // One lane per horizon, padded to a multiple of 4
+    std::vector<double> alpha_;
+    std::vector<double> decay_;   // 1 - alpha
+    std::vector<double> limit_;   // Window as a double, for the warm-up test
+    std::vector<double> mean_;
+    std::vector<double> variance_;
+    std::vector<double> m2_;      // Welford second moment during warm-up
+    size_t maxWindow_;            // All horizons warm from here on
+    size_t count_;
+};
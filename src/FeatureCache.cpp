@@ -0,0 +1,270 @@
+#include "FeatureCache.hpp"
+#include "MarketDataReader.hpp"
+#include "FixedRollingStatistics.hpp"
+#include "TickCache.hpp"
+#include "TickFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kBatchSize = 4096;
+
+template<typename T>
+uint64_t hashValue(uint64_t hash, const T& value) {
+    return tickChecksum(&value, sizeof(value), hash);
+}
+
+std::string hex(uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+    return buf;
+}
+
+}  // namespace
+
+MappedFeatureFile::MappedFeatureFile(const std::string& path)
+    : data_(nullptr), size_(0) {
+#ifdef _WIN32
+    HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(hFile);
+        return;
+    }
+    HANDLE hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (hMap != nullptr) {
+        data_ = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(hMap);
+    }
+    CloseHandle(hFile);
+    size_ = data_ ? static_cast<size_t>(fileSize.QuadPart) : 0;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0) {
+        close(fd);
+        return;
+    }
+    data_ = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        return;
+    }
+    size_ = st.st_size;
+#endif
+}
+
+MappedFeatureFile::~MappedFeatureFile() {
+    unmap();
+}
+
+MappedFeatureFile::MappedFeatureFile(MappedFeatureFile&& other) noexcept
+    : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFeatureFile& MappedFeatureFile::operator=(MappedFeatureFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void MappedFeatureFile::unmap() {
+    if (data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        munmap(data_, size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+const FeatureFileHeader* MappedFeatureFile::header() const {
+    if (!data_ || size_ < sizeof(FeatureFileHeader)) {
+        return nullptr;
+    }
+    const FeatureFileHeader* h = static_cast<const FeatureFileHeader*>(data_);
+    if (std::memcmp(h->magic, kFeatureFileMagic, sizeof(kFeatureFileMagic)) != 0 ||
+        h->version != kFeatureFileVersion || h->recordSize == 0 ||
+        h->recordCount > (size_ - sizeof(FeatureFileHeader)) / h->recordSize) {
+        return nullptr;
+    }
+    return h;
+}
+
+FeatureCache::FeatureCache(const std::string& dataFile, const ValidationOptions& validation)
+    : dataFile_(dataFile),
+      directory_(dataFile + ".features"),
+      validation_(validation),
+      sourceHash_(0),
+      valid_(TickCache::fingerprint(dataFile, sourceHash_)) {}
+
+uint64_t FeatureCache::paramsHash(const char* kind, uint64_t seed) const {
+    uint64_t hash = tickChecksum(kind, std::strlen(kind), seed);
+    hash = hashValue(hash, validation_.crossed);
+    hash = hashValue(hash, validation_.locked);
+    hash = hashValue(hash, validation_.badPrice);
+    hash = hashValue(hash, validation_.outOfOrder);
+    return hash;  // maxGap only affects counters
+}
+
+template<typename T, typename Build>
+FeatureSeries<T> FeatureCache::load(const std::string& name, uint64_t params, Build build) {
+    if (!valid_) {
+        throw std::runtime_error("Feature cache needs a regular data file: " + dataFile_);
+    }
+    
+    std::string path = (fs::path(directory_) / name).string();
+    MappedFeatureFile cached(path);
+    const FeatureFileHeader* header = cached.header();
+    if (header && header->sourceHash == sourceHash_ && header->paramsHash == params &&
+        header->recordSize == sizeof(T) &&
+        tickChecksum(cached.records(), header->recordSize * header->recordCount) == header->checksum) {
+        return FeatureSeries<T>(std::move(cached));
+    }
+    cached = MappedFeatureFile();  // Stale or corrupt: rebuild
+    
+    ValidationStats quality;
+    std::vector<T> records = build(quality);
+    write(name, params, records.data(), sizeof(T), records.size(), quality);
+    
+    FeatureSeries<T> series{MappedFeatureFile(path)};
+    if (series.size() != records.size()) {
+        throw std::runtime_error("Failed to map feature file: " + path);
+    }
+    return series;
+}
+
+void FeatureCache::write(const std::string& name, uint64_t params, const void* records,
+                         size_t recordSize, size_t count, const ValidationStats& quality) const {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    
+    FeatureFileHeader header{};
+    std::memcpy(header.magic, kFeatureFileMagic, sizeof(kFeatureFileMagic));
+    header.version = kFeatureFileVersion;
+    header.recordSize = static_cast<uint32_t>(recordSize);
+    header.sourceHash = sourceHash_;
+    header.paramsHash = params;
+    header.recordCount = count;
+    header.checksum = tickChecksum(records, recordSize * count);
+    header.quality = quality;
+    
+    // Private name, then rename, so concurrent runs only see complete files
+    fs::path path = fs::path(directory_) / name;
+    fs::path temp = fs::path(directory_) / (name + "." + std::to_string(getpid()) + ".tmp");
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(static_cast<const char*>(records), static_cast<std::streamsize>(recordSize * count));
+        if (!out.good()) {
+            out.close();
+            fs::remove(temp, ec);
+            throw std::runtime_error("Failed to write feature file: " + temp.string());
+        }
+    }
+    fs::rename(temp, path, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        throw std::runtime_error("Failed to publish feature file: " + path.string());
+    }
+}
+
+FeatureSeries<MidPoint> FeatureCache::mids() {
+    return load<MidPoint>("mid.atf", paramsHash("mid", 0), [this](ValidationStats& quality) {
+        MarketDataReader reader(dataFile_);
+        if (!reader.isValid()) {
+            throw std::runtime_error("Failed to open data file: " + dataFile_);
+        }
+        TickValidator validator(validation_);
+        std::vector<MidPoint> mids;
+        mids.reserve(reader.tickCount());
+        TickView batch;
+        while (!(batch = reader.nextView(kBatchSize)).empty()) {
+            for (const Tick& tick : validator.apply(batch)) {
+                mids.push_back(MidPoint{tick.timestamp, tick.mid()});
+            }
+        }
+        throwIfReadFailed(reader, dataFile_);
+        quality = validator.stats();
+        return mids;
+    });
+}
+
+FeatureSeries<EwmaPoint> FeatureCache::ewma(size_t window, StatisticsMode mode) {
+    bool sliding = mode == StatisticsMode::Sliding;
+    const char* name = sliding ? "sliding" : "ewma";
+    uint64_t params = hashValue(paramsHash(name, 0), static_cast<uint64_t>(window));
+    return load<EwmaPoint>(name + ("-" + std::to_string(window)) + ".atf", params, [this, window, mode](ValidationStats&) {
+        FeatureSeries<MidPoint> source = mids();
+        return DefaultStatisticsRegistry::dispatch(window, mode, [&source](auto& stats) {
+            std::vector<EwmaPoint> points;
+            points.reserve(source.size());
+            for (const MidPoint& point : source) {
+                stats.update(point.mid);
+                points.push_back(EwmaPoint{stats.mean(), stats.variance()});
+            }
+            return points;
+        });
+    });
+}
+
+FeatureSeries<Bar> FeatureCache::bars(const BarSpec& spec) {
+    uint64_t params = hashValue(hashValue(paramsHash("bars", 0), spec.type), spec.size);
+    return load<Bar>("bars-" + hex(params) + ".atf", params, [this, &spec](ValidationStats& quality) {
+        MarketDataReader reader(dataFile_);
+        if (!reader.isValid()) {
+            throw std::runtime_error("Failed to open data file: " + dataFile_);
+        }
+        TickValidator validator(validation_);
+        BarBuilder builder(spec);
+        std::vector<Bar> bars;
+        TickView batch;
+        while (!(batch = reader.nextView(kBatchSize)).empty()) {
+            builder.add(validator.apply(batch), bars);
+        }
+        throwIfReadFailed(reader, dataFile_);
+        quality = validator.stats();
+        Bar last;
+        if (builder.flush(last)) {
+            bars.push_back(last);
+        }
+        return bars;
+    });
+}
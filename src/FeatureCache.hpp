@@ -0,0 +1,127 @@
+#pragma once
+
+#include "BarBuilder.hpp"
+#include "RollingStatistics.hpp"
+#include "TickValidator.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Derived series cached on disk next to a data file, in
+// "<data file>.features/". Each series is one file: a 128-byte
+// FeatureFileHeader followed by fixed-width records, mapped read-only on
+// later runs. Headers carry the source fingerprint (TickCache::fingerprint)
+// and a hash of the parameters, so a changed source or different settings
+// rebuild the file instead of reusing it. The record checksum is verified
+// on every load, and a torn or corrupt file is rebuilt as well.
+
+constexpr char kFeatureFileMagic[8] = {'A', 'R', 'T', 'F', 'E', 'A', 'T', '\0'};
+constexpr uint32_t kFeatureFileVersion = 2;
+
+struct FeatureFileHeader {
+    char magic[8];          // kFeatureFileMagic
+    uint32_t version;       // kFeatureFileVersion
+    uint32_t recordSize;
+    uint64_t sourceHash;    // Fingerprint of the data file
+    uint64_t paramsHash;    // Series kind and parameters
+    uint64_t recordCount;
+    uint64_t checksum;      // tickChecksum() over the record bytes
+    ValidationStats quality;  // Validator counts over the source (mids, bars)
+    uint64_t reserved[2];
+};
+
+static_assert(sizeof(FeatureFileHeader) == 128, "FeatureFileHeader must stay 128 bytes");
+
+// Mid price of one validated tick
+struct MidPoint {
+    int64_t timestamp;
+    double mid;
+};
+
+// RollingStatistics state after each mid (either StatisticsMode)
+struct EwmaPoint {
+    double mean;
+    double variance;
+};
+
+// Read-only mapping of one feature file
+class MappedFeatureFile {
+public:
+    MappedFeatureFile() : data_(nullptr), size_(0) {}
+    explicit MappedFeatureFile(const std::string& path);
+    ~MappedFeatureFile();
+    
+    MappedFeatureFile(const MappedFeatureFile&) = delete;
+    MappedFeatureFile& operator=(const MappedFeatureFile&) = delete;
+    MappedFeatureFile(MappedFeatureFile&& other) noexcept;
+    MappedFeatureFile& operator=(MappedFeatureFile&& other) noexcept;
+    
+    // Null if the file is missing, truncated or not a feature file
+    const FeatureFileHeader* header() const;
+    const void* records() const { return static_cast<const char*>(data_) + sizeof(FeatureFileHeader); }
+
+private:
+    void* data_;
+    size_t size_;
+    
+    void unmap();
+};
+
+// Typed view of a mapped series; owns the mapping
+template<typename T>
+class FeatureSeries {
+public:
+    FeatureSeries() = default;
+    explicit FeatureSeries(MappedFeatureFile file) : file_(std::move(file)) {}
+    
+    const T* data() const { return static_cast<const T*>(file_.records()); }
+    size_t size() const { return file_.header() ? static_cast<size_t>(file_.header()->recordCount) : 0; }
+    bool empty() const { return size() == 0; }
+    const T& operator[](size_t i) const { return data()[i]; }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size(); }
+    
+    // Validator counts from building the series (zero for derived series)
+    ValidationStats quality() const { return file_.header() ? file_.header()->quality : ValidationStats(); }
+
+private:
+    MappedFeatureFile file_;
+};
+
+class FeatureCache {
+public:
+    // Series for dataFile (a regular CSV, .atk or .atc file). Ticks are
+    // passed through a TickValidator with the given options first; the
+    // options are part of every key.
+    explicit FeatureCache(const std::string& dataFile,
+                          const ValidationOptions& validation = ValidationOptions());
+    
+    // Each call maps the cached series, building it first if it is missing
+    // or stale. Throws std::runtime_error if the source cannot be read or
+    // the series cannot be written.
+    FeatureSeries<MidPoint> mids();
+    FeatureSeries<EwmaPoint> ewma(size_t window,  // RollingStatistics over mids()
+                                  StatisticsMode mode = StatisticsMode::Ewma);
+    FeatureSeries<Bar> bars(const BarSpec& spec);
+    
+    // False if the data file is not a regular file
+    bool isValid() const { return valid_; }
+    
+    const std::string& directory() const { return directory_; }
+
+private:
+    std::string dataFile_;
+    std::string directory_;
+    ValidationOptions validation_;
+    uint64_t sourceHash_;
+    bool valid_;
+    
+    uint64_t paramsHash(const char* kind, uint64_t seed) const;
+    
+    // Map the series if current, otherwise write records from
+    // build(quality) and map that
+    template<typename T, typename Build>
+    FeatureSeries<T> load(const std::string& name, uint64_t params, Build build);
+    void write(const std::string& name, uint64_t params, const void* records,
+               size_t recordSize, size_t count, const ValidationStats& quality) const;
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "RollingStatistics.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+// RollingStatistics with the window, mode and precision fixed at compile
+// time. alpha, 1 - alpha and the ring mask are constants and the update is
+// inlined into the caller's loop. Single-threaded. With Real = double the
+// results match RollingStatistics(Window, Mode) exactly.
+template<size_t Window, StatisticsMode Mode = StatisticsMode::Ewma, typename Real = double>
+class FixedRollingStatistics {
+    static_assert(Window > 0, "Window must be positive");
+    
+public:
+    static constexpr size_t kWindow = Window;
+    static constexpr StatisticsMode kMode = Mode;
+    
+    FixedRollingStatistics()
+        : count_(0), mean_(0), variance_(0), m2_(0), shift_(0) {
+        if constexpr (Mode == StatisticsMode::Sliding) {
+            buffer_.reset(new Real[kCapacity]());
+        }
+    }
+    
+    // Non-copyable
+    FixedRollingStatistics(const FixedRollingStatistics&) = delete;
+    FixedRollingStatistics& operator=(const FixedRollingStatistics&) = delete;
+    
+    void update(Real value) {
+        size_t oldCount = count_++;
+    
+        if constexpr (Mode == StatisticsMode::Sliding) {
+            updateSliding(value, oldCount);
+        } else if (oldCount < Window) {
+            // Initial fill phase: Welford's online algorithm
+            if (oldCount == 0) {
+                mean_ = value;
+                variance_ = 0;
+                m2_ = 0;
+            } else {
+                Real delta = value - mean_;
+                mean_ += delta / (oldCount + 1);
+                Real delta2 = value - mean_;
+                m2_ += delta * delta2;
+                variance_ = m2_ / (oldCount + 1);
+            }
+        } else {
+            Real oldMean = mean_;
+            mean_ = kAlpha * value + kDecay * mean_;
+            Real delta = value - oldMean;
+            variance_ = kDecay * (variance_ + kAlpha * delta * delta);
+            if (variance_ < 0) {
+                variance_ = 0;
+            }
+        }
+    }
+    
+    // Forget all values, as if newly constructed
+    void reset() {
+        count_ = 0;
+        mean_ = 0;
+        variance_ = 0;
+        m2_ = 0;
+    }
+    
+    double mean() const { return mean_; }
+    double variance() const { return variance_; }
+    double stddev() const { return std::sqrt(variance()); }
+    double zscore(double value) const {
+        double sd = stddev();
+        return sd > 1e-10 ? (value - mean()) / sd : 0.0;
+    }
+    
+    size_t count() const { return count_; }
+    bool isReady() const { return count_ >= Window; }
+    StatisticsMode mode() const { return Mode; }
+    
+private:
+    static constexpr Real kAlpha = Real(2.0 / (Window + 1.0));
+    static constexpr Real kDecay = Real(1.0) - kAlpha;
+    
+    // Power-of-two ring; eviction looks back exactly Window slots
+    static constexpr size_t kCapacity = [] {
+        size_t capacity = 8;
+        while (capacity < Window) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }();
+    static constexpr size_t kMask = kCapacity - 1;
+    
+    std::unique_ptr<Real[]> buffer_;  // Sliding mode only
+    size_t count_;
+    Real mean_;
+    Real variance_;
+    Real m2_;
+    
+    // Sliding mode, as in RollingStatistics
+    Real shift_;
+    CompensatedSum<Real> sum_;
+    CompensatedSum<Real> sumSquares_;
+    
+    void updateSliding(Real value, size_t oldCount) {
+        if (oldCount == 0) {
+            shift_ = value;
+            sum_ = CompensatedSum<Real>();
+            sumSquares_ = CompensatedSum<Real>();
+        }
+        if (oldCount >= Window) {
+            Real old = buffer_[(oldCount - Window) & kMask] - shift_;
+            sum_.add(-old);
+            sumSquares_.add(-old * old);
+        }
+        buffer_[oldCount & kMask] = value;
+    
+        Real d = value - shift_;
+        sum_.add(d);
+        sumSquares_.add(d * d);
+    
+        Real n = static_cast<Real>(std::min(oldCount + 1, Window));
+        Real sum = sum_.value();
+        mean_ = shift_ + sum / n;
+        variance_ = std::max(Real(0), (sumSquares_.value() - sum * sum / n) / n);
+    }
+};
+
+// Windows with a compiled-in FixedRollingStatistics. dispatch() picks the
+// matching instance once per run and calls fn(stats) with it; other
+// windows get a runtime RollingStatistics, so every window works.
+// fn must return the same type for every statistics type.
+template<size_t... Windows>
+class StatisticsRegistry {
+public:
+    static bool contains(size_t window) {
+        return ((window == Windows) || ...);
+    }
+    
+    template<typename Fn>
+    static auto dispatch(size_t window, StatisticsMode mode, Fn&& fn) {
+        return dispatchFrom<Windows...>(window, mode, fn);
+    }
+    
+private:
+    template<typename Fn>
+    static auto dispatchFrom(size_t window, StatisticsMode mode, Fn& fn) {
+        RollingStatistics stats(window, mode);
+        return fn(stats);
+    }
+    
+    template<size_t W, size_t... Rest, typename Fn>
+    static auto dispatchFrom(size_t window, StatisticsMode mode, Fn& fn) {
+        if (window == W) {
+            if (mode == StatisticsMode::Sliding) {
+                FixedRollingStatistics<W, StatisticsMode::Sliding> stats;
+                return fn(stats);
+            }
+            FixedRollingStatistics<W, StatisticsMode::Ewma> stats;
+            return fn(stats);
+        }
+        return dispatchFrom<Rest...>(window, mode, fn);
+    }
+};
+
+// Common tick windows (the backtester uses 20k)
+using DefaultStatisticsRegistry = StatisticsRegistry<5000, 20000, 100000>;
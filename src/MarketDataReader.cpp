@@ -1,8 +1,17 @@
 #include "MarketDataReader.hpp"
+#include "TickParser.hpp"
+#include "TickFile.hpp"
+#include "TickStore.hpp"
 #include <fstream>
+#include <cerrno>
 #include <cstring>
 #include <algorithm>
+#include <thread>
+#include <limits>
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <stdexcept>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -16,8 +25,98 @@
 #include <unistd.h>
 #endif
 
-MarketDataReader::MarketDataReader(const std::string& filepath)
-    : data_(nullptr), size_(0), position_(0), filepath_(filepath) {
+namespace {
+
+constexpr size_t kDefaultReadaheadMiB = 64;  // MapOptions::parse("readahead")
+
+}  // namespace
+
+// Touches one byte per page between the consumer's cursor and
+// cursor + distance, so first-touch faults are taken off the parse thread.
+// The worker exits once it has touched the end of the file.
+struct MarketDataReader::Readahead {
+    const size_t distance;
+    std::atomic<size_t> cursor;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> done{false};
+    std::thread worker;
+    
+    Readahead(const char* data, size_t size, size_t distance, size_t start)
+        : distance(distance), cursor(start) {
+        worker = std::thread([this, data, size, distance]() {
+#ifdef _WIN32
+            const size_t pageSize = 4096;
+#else
+            const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+            size_t touched = 0;
+            volatile char sink = 0;
+            while (!stop.load(std::memory_order_relaxed) && touched < size) {
+                size_t pos = cursor.load(std::memory_order_relaxed);
+                size_t target = std::min(size, pos + distance);
+                touched = std::max(touched, pos - pos % pageSize);
+                if (touched >= target) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    continue;
+                }
+                for (; touched < target; touched += pageSize) {
+                    sink = sink + data[touched];
+                }
+            }
+            done.store(true, std::memory_order_release);
+        });
+    }
+    
+    ~Readahead() {
+        stop.store(true, std::memory_order_relaxed);
+        worker.join();
+    }
+};
+
+MapOptions MapOptions::parse(const std::string& spec) {
+    MapOptions options;
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+        if (item == "random") {
+            options.sequential = false;
+        } else if (item == "willneed") {
+            options.willNeed = true;
+        } else if (item == "populate") {
+            options.populate = true;
+        } else if (item == "hugepage") {
+            options.hugePages = true;
+        } else if (item == "readahead") {
+            options.readaheadBytes = kDefaultReadaheadMiB << 20;
+        } else if (item.compare(0, 10, "readahead=") == 0) {
+            size_t used = 0;
+            unsigned long mib = 0;
+            try {
+                mib = std::stoul(item.substr(10), &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != item.size() - 10 || mib == 0) {
+                throw std::invalid_argument("Invalid readahead size: " + item);
+            }
+            options.readaheadBytes = static_cast<size_t>(mib) << 20;
+        } else {
+            throw std::invalid_argument("Unknown mapping option: " + item);
+        }
+    }
+    return options;
+}
+
+MarketDataReader::MarketDataReader(const std::string& filepath, const MapOptions& options)
+    : data_(nullptr), size_(0), position_(0), origin_(0), end_(0), format_(Format::CSV), filepath_(filepath),
+      startTimestamp_(std::numeric_limits<int64_t>::min()),
+      stopTimestamp_(std::numeric_limits<int64_t>::max()),
+      tickCount_(std::numeric_limits<size_t>::max()),
+      error_(0),
+      decodedPos_(0) {
     
 #ifdef _WIN32
     HANDLE hFile = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ,
@@ -55,7 +154,13 @@ MarketDataReader::MarketDataReader(const std::string& filepath)
     }
     size_ = st.st_size;
     
-    data_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    if (options.populate) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    data_ = mmap(nullptr, size_, PROT_READ, flags, fd, 0);
     close(fd);
     
     if (data_ == MAP_FAILED) {
@@ -64,18 +169,85 @@ MarketDataReader::MarketDataReader(const std::string& filepath)
     }
 #endif
     
-    // Skip header line if present
-    if (data_ && size_ > 0) {
-        const char* start = static_cast<const char*>(data_);
-        const char* end = start + size_;
-        const char* nl = static_cast<const char*>(memchr(start, '\n', size_));
-        if (nl && nl < end) {
-            position_ = (nl - start) + 1;
-        }
+    end_ = size_;
+    if (isTickFile(data_, size_)) {
+        format_ = Format::Binary;
+        end_ = sizeof(TickFileHeader) + binaryHeader().recordCount * sizeof(Tick);
+    } else if (isColumnStore(data_, size_)) {
+        format_ = Format::Columnar;
+        end_ = columnHeader().blockCount;
+    } else if (data_ && size_ >= sizeof(kTickFileMagic) &&
+               (std::memcmp(data_, kTickFileMagic, sizeof(kTickFileMagic)) == 0 ||
+                std::memcmp(data_, kColumnStoreMagic, sizeof(kColumnStoreMagic)) == 0)) {
+        unmap();  // Truncated or incompatible binary file
     }
+    
+    applyMapOptions(options);
+    
+    // Skip header
+    rewind();
+}
+
+MarketDataReader::MarketDataReader(const std::string& filepath, int64_t from, int64_t to,
+                                   const MapOptions& options)
+    : MarketDataReader(filepath, options) {
+    startTimestamp_ = from;
+    stopTimestamp_ = to;
+    reset();
 }
 
 MarketDataReader::~MarketDataReader() {
+    unmap();
+}
+
+void MarketDataReader::applyMapOptions(const MapOptions& options) {
+    if (!data_) {
+        return;
+    }
+    
+#ifndef _WIN32
+    if (options.sequential) {
+        madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    if (options.willNeed) {
+        madvise(data_, size_, MADV_WILLNEED);
+    }
+#ifdef MADV_HUGEPAGE
+    if (options.hugePages) {
+        madvise(data_, size_, MADV_HUGEPAGE);  // Best effort; needs file THP support
+    }
+#endif
+#endif
+    
+    if (options.readaheadBytes > 0) {
+        readahead_.reset(new Readahead(static_cast<const char*>(data_), size_, options.readaheadBytes, 0));
+    }
+}
+
+size_t MarketDataReader::cursorOffset() const {
+    if (format_ == Format::Columnar) {
+        return position_ < end_ ? blockIndex(position_).offset : size_;
+    }
+    return position_;
+}
+
+void MarketDataReader::publishCursor() {
+    if (readahead_) {
+        readahead_->cursor.store(cursorOffset(), std::memory_order_relaxed);
+    }
+}
+
+void MarketDataReader::restartReadahead() {
+    if (readahead_ && readahead_->done.load(std::memory_order_acquire)) {
+        size_t distance = readahead_->distance;
+        readahead_.reset(new Readahead(static_cast<const char*>(data_), size_, distance, cursorOffset()));
+    } else {
+        publishCursor();
+    }
+}
+
+void MarketDataReader::unmap() {
+    readahead_.reset();  // Stop touching pages before they go away
     if (data_) {
 #ifdef _WIN32
         UnmapViewOfFile(data_);
@@ -83,105 +255,544 @@ MarketDataReader::~MarketDataReader() {
         munmap(data_, size_);
 #endif
     }
+    data_ = nullptr;
+    size_ = 0;
+    position_ = 0;
+    end_ = 0;
+    decoded_.clear();
+    decodedPos_ = 0;
 }
 
 MarketDataReader::MarketDataReader(MarketDataReader&& other) noexcept
-    : data_(other.data_), size_(other.size_), position_(other.position_), filepath_(std::move(other.filepath_)) {
+    : data_(other.data_), size_(other.size_), position_(other.position_), origin_(other.origin_),
+      end_(other.end_),
+      format_(other.format_), filepath_(std::move(other.filepath_)),
+      startTimestamp_(other.startTimestamp_), stopTimestamp_(other.stopTimestamp_),
+      tickCount_(other.tickCount_), error_(other.error_),
+      decoded_(std::move(other.decoded_)), decodedPos_(other.decodedPos_),
+      readahead_(std::move(other.readahead_)) {
     other.data_ = nullptr;
     other.size_ = 0;
     other.position_ = 0;
+    other.end_ = 0;
 }
 
 MarketDataReader& MarketDataReader::operator=(MarketDataReader&& other) noexcept {
     if (this != &other) {
-        if (data_) {
-#ifdef _WIN32
-            UnmapViewOfFile(data_);
-#else
-            munmap(data_, size_);
-#endif
-        }
+        unmap();
         data_ = other.data_;
         size_ = other.size_;
         position_ = other.position_;
+        origin_ = other.origin_;
+        end_ = other.end_;
+        format_ = other.format_;
         filepath_ = std::move(other.filepath_);
+        startTimestamp_ = other.startTimestamp_;
+        stopTimestamp_ = other.stopTimestamp_;
+        tickCount_ = other.tickCount_;
+        error_ = other.error_;
+        decoded_ = std::move(other.decoded_);
+        decodedPos_ = other.decodedPos_;
+        readahead_ = std::move(other.readahead_);
         other.data_ = nullptr;
         other.size_ = 0;
         other.position_ = 0;
+        other.end_ = 0;
     }
     return *this;
 }
 
-bool MarketDataReader::parseLine(const char* line, size_t len, Tick& tick) {
-    // Format: timestamp,bid,ask,volume
-    std::string str(line, len);
-    std::istringstream iss(str);
-    std::string token;
+bool MarketDataReader::next(Tick& tick) {
+    if (!readTick(tick)) {
+        return false;
+    }
+    if (tick.timestamp >= stopTimestamp_) {
+        exhaust();
+        return false;
+    }
+    publishCursor();
+    return true;
+}
+
+size_t MarketDataReader::nextBatch(Tick* out, size_t maxTicks) {
+    size_t n = clipToRange(out, readBatch(out, maxTicks));
+    publishCursor();
+    return n;
+}
+
+size_t MarketDataReader::clipToRange(const Tick* ticks, size_t n) {
+    if (n == 0 || ticks[n - 1].timestamp < stopTimestamp_) {
+        return n;
+    }
     
-    if (!std::getline(iss, token, ',')) return false;
-    tick.timestamp = std::stoll(token);
+    // Timestamps are ordered, so everything from the first tick past the
+    // range onwards is dropped and the reader is done
+    const Tick* stop = std::lower_bound(ticks, ticks + n, stopTimestamp_,
+                                        [](const Tick& t, int64_t ts) { return t.timestamp < ts; });
+    exhaust();
+    return stop - ticks;
+}
+
+void MarketDataReader::exhaust() {
+    position_ = end_;
+    decodedPos_ = decoded_.size();  // Keep the block: a returned view may point into it
+}
+
+TickView MarketDataReader::nextView(size_t maxTicks) {
+    const Tick* first = nullptr;
+    size_t n = 0;
     
-    if (!std::getline(iss, token, ',')) return false;
-    tick.bid = std::stod(token);
+    if (format_ == Format::Columnar) {
+        if (decodedPos_ < decoded_.size() || decodeNextBlock()) {
+            first = decoded_.data() + decodedPos_;
+            n = std::min(maxTicks, decoded_.size() - decodedPos_);
+            decodedPos_ += n;
+        }
+    } else if (format_ == Format::Binary) {
+        if (data_ && position_ < end_) {
+            // Records start 64 bytes into a page-aligned mapping, so they
+            // are suitably aligned to be read as Ticks in place
+            first = reinterpret_cast<const Tick*>(static_cast<const char*>(data_) + position_);
+            n = std::min(maxTicks, (end_ - position_) / sizeof(Tick));
+            position_ += n * sizeof(Tick);
+        }
+    } else {
+        return TickSource::nextView(maxTicks);
+    }
     
-    if (!std::getline(iss, token, ',')) return false;
-    tick.ask = std::stod(token);
+    n = clipToRange(first, n);
+    publishCursor();
+    return TickView{first, first + n};
+}
+
+bool MarketDataReader::readTick(Tick& tick) {
+    if (format_ == Format::Columnar) {
+        if (decodedPos_ == decoded_.size() && !decodeNextBlock()) {
+            return false;
+        }
+        tick = decoded_[decodedPos_++];
+        return true;
+    }
     
-    if (!std::getline(iss, token, ',')) return false;
-    tick.volume = std::stoll(token);
+    if (!data_ || position_ >= end_) {
+        return false;
+    }
     
-    return true;
+    const char* start = static_cast<const char*>(data_);
+    
+    if (format_ == Format::Binary) {
+        std::memcpy(&tick, start + position_, sizeof(Tick));
+        position_ += sizeof(Tick);
+        return true;
+    }
+    
+    const char* current = start + position_;
+    const char* end = start + end_;
+    
+    // Skip empty/invalid lines
+    while (current < end) {
+        bool ok;
+        current = TickParser::parseNext(current, end, tick, ok);
+        if (ok) {
+            position_ = current - start;
+            return true;
+        }
+    }
+    
+    position_ = end_;
+    return false;
 }
 
-bool MarketDataReader::next(Tick& tick) {
-    if (!data_ || position_ >= size_) {
-        return false;
+size_t MarketDataReader::readBatch(Tick* out, size_t maxTicks) {
+    if (format_ == Format::Columnar) {
+        size_t n = 0;
+        while (n < maxTicks) {
+            if (decodedPos_ == decoded_.size() && !decodeNextBlock()) {
+                break;
+            }
+            size_t take = std::min(maxTicks - n, decoded_.size() - decodedPos_);
+            std::memcpy(out + n, decoded_.data() + decodedPos_, take * sizeof(Tick));
+            decodedPos_ += take;
+            n += take;
+        }
+        return n;
+    }
+    
+    if (!data_ || position_ >= end_) {
+        return 0;
     }
     
     const char* start = static_cast<const char*>(data_);
+    
+    if (format_ == Format::Binary) {
+        size_t n = std::min(maxTicks, (end_ - position_) / sizeof(Tick));
+        std::memcpy(out, start + position_, n * sizeof(Tick));
+        position_ += n * sizeof(Tick);
+        return n;
+    }
+    
     const char* current = start + position_;
-    const char* end = start + size_;
+    const char* end = start + end_;
     
-    // Find next newline
-    const char* nl = static_cast<const char*>(memchr(current, '\n', end - current));
-    if (!nl) {
-        nl = end;  // Last line may not have newline
+    size_t n = 0;
+    while (n < maxTicks && current < end) {
+        bool ok;
+        current = TickParser::parseNext(current, end, out[n], ok);
+        n += ok;  // Invalid lines are overwritten by the next one
     }
     
-    if (nl <= current) {
-        return false;
+    position_ = current - start;
+    return n;
+}
+
+std::vector<Tick> MarketDataReader::readAll(unsigned threads) {
+    std::vector<Tick> ticks;
+    
+    if (format_ != Format::CSV) {
+        ticks.reserve(approximateTickCount());
+        Tick tick;
+        while (next(tick)) {
+            ticks.push_back(tick);
+        }
+        return ticks;
     }
     
-    // Parse line
-    size_t lineLen = nl - current;
-    if (lineLen > 0 && current[lineLen - 1] == '\r') {
-        lineLen--;  // Remove Windows line ending
+    if (!data_ || position_ >= end_) {
+        return ticks;
     }
     
-    if (lineLen > 0 && parseLine(current, lineLen, tick)) {
-        position_ = (nl - start) + 1;
-        return true;
+    const char* start = static_cast<const char*>(data_);
+    const char* begin = start + position_;
+    const char* end = start + end_;
+    
+    // Small inputs are not worth the thread startup
+    const size_t minChunkBytes = 1 << 20;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, (end - begin) / minChunkBytes));
+    
+    // Chunk boundaries, each moved forward to the start of a line
+    std::vector<const char*> bounds(chunks + 1);
+    bounds[0] = begin;
+    bounds[chunks] = end;
+    for (size_t i = 1; i < chunks; ++i) {
+        const char* p = begin + (end - begin) * i / chunks;
+        p = std::max(p, bounds[i - 1]);
+        p = TickParser::findNewline(p, end);
+        bounds[i] = p < end ? p + 1 : end;
     }
     
-    position_ = (nl - start) + 1;
-    return next(tick);  // Skip empty/invalid lines
+    std::vector<std::vector<Tick>> parts(chunks);
+    auto parse = [&](size_t i) {
+        std::vector<Tick>& out = parts[i];
+        out.reserve((bounds[i + 1] - bounds[i]) / 32);
+        const char* p = bounds[i];
+        Tick tick;
+        while (p < bounds[i + 1]) {
+            bool ok;
+            p = TickParser::parseNext(p, bounds[i + 1], tick, ok);
+            if (ok) {
+                out.push_back(tick);
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks; ++i) {
+        workers.emplace_back(parse, i);
+    }
+    parse(0);
+    for (auto& t : workers) {
+        t.join();
+    }
+    
+    // Stitch in file order
+    size_t total = 0;
+    for (const auto& part : parts) {
+        total += part.size();
+    }
+    ticks.reserve(total);
+    for (auto& part : parts) {
+        ticks.insert(ticks.end(), part.begin(), part.end());
+        std::vector<Tick>().swap(part);
+    }
+    
+    ticks.resize(clipToRange(ticks.data(), ticks.size()));
+    position_ = end_;
+    return ticks;
 }
 
 void MarketDataReader::reset() {
+    rewind();
+    if (startTimestamp_ != std::numeric_limits<int64_t>::min()) {
+        locate(startTimestamp_);
+    }
+    restartReadahead();
+}
+
+bool MarketDataReader::seek(int64_t timestamp) {
+    bool found = locate(timestamp);
+    restartReadahead();
+    return found;
+}
+
+bool MarketDataReader::locate(int64_t timestamp) {
+    timestamp = std::max(timestamp, startTimestamp_);  // Never before the range
+    rewind();
+    if (!data_) {
+        return false;
+    }
+    
+    const char* start = static_cast<const char*>(data_);
+    
+    if (format_ == Format::Binary) {
+        // lower_bound over fixed-width records
+        size_t lo = 0;
+        size_t hi = (end_ - position_) / sizeof(Tick);
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            int64_t ts;
+            std::memcpy(&ts, start + position_ + mid * sizeof(Tick), sizeof(ts));
+            if (ts < timestamp) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        position_ += lo * sizeof(Tick);
+        return position_ < end_;
+    }
+    
+    if (format_ == Format::Columnar) {
+        // First block whose max timestamp reaches the target, then
+        // lower_bound inside the decoded block
+        size_t lo = 0;
+        size_t hi = end_;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (blockIndex(mid).maxTimestamp < timestamp) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        position_ = lo;
+        if (!decodeNextBlock()) {
+            return false;
+        }
+        auto it = std::lower_bound(decoded_.begin(), decoded_.end(), timestamp,
+                                   [](const Tick& t, int64_t ts) { return t.timestamp < ts; });
+        decodedPos_ = it - decoded_.begin();
+        return decodedPos_ < decoded_.size() || decodeNextBlock();
+    }
+    
+    // CSV: bisect byte offsets, resyncing to the next line start at each
+    // probe, until the window is small enough to scan
+    const size_t scanBytes = 4096;
+    size_t lo = position_;  // Always a line start with all earlier ticks < timestamp
+    size_t hi = end_;
+    while (hi - lo > scanBytes) {
+        const char* mid = TickParser::findNewline(start + lo + (hi - lo) / 2, start + hi);
+        if (mid >= start + hi) {
+            break;
+        }
+        const char* line = mid + 1;
+        
+        // First valid tick at or after the probe
+        const char* p = line;
+        const char* hiPtr = start + hi;
+        Tick tick;
+        bool ok = false;
+        while (p < hiPtr && !ok) {
+            p = TickParser::parseNext(p, hiPtr, tick, ok);
+        }
+        
+        if (ok && tick.timestamp < timestamp) {
+            lo = p - start;
+        } else {
+            hi = line - start;
+        }
+    }
+    
+    // Linear scan for the first tick >= timestamp
+    const char* p = start + lo;
+    const char* end = start + end_;
+    while (p < end) {
+        Tick tick;
+        bool ok;
+        const char* nextLine = TickParser::parseNext(p, end, tick, ok);
+        if (ok && tick.timestamp >= timestamp) {
+            break;
+        }
+        p = nextLine;
+    }
+    position_ = p - start;
+    return position_ < end_;
+}
+
+void MarketDataReader::rewind() {
     position_ = 0;
-    // Skip header
+    error_ = 0;
+    decoded_.clear();
+    decodedPos_ = 0;
     if (data_ && size_ > 0) {
-        const char* start = static_cast<const char*>(data_);
-        const char* nl = static_cast<const char*>(memchr(start, '\n', size_));
-        if (nl) {
-            position_ = (nl - start) + 1;
+        if (format_ == Format::Binary) {
+            position_ = sizeof(TickFileHeader);
+        } else if (format_ == Format::CSV) {
+            // Skip CSV header line
+            const char* start = static_cast<const char*>(data_);
+            const char* nl = static_cast<const char*>(memchr(start, '\n', size_));
+            if (nl) {
+                position_ = (nl - start) + 1;
+            }
         }
+        // Columnar starts at block 0
     }
+    origin_ = position_;
+}
+
+bool MarketDataReader::atStart() const {
+    return startTimestamp_ == std::numeric_limits<int64_t>::min() &&
+           stopTimestamp_ == std::numeric_limits<int64_t>::max() &&
+           position_ == origin_ && decoded_.empty();
+}
+
+bool MarketDataReader::timeBounds(int64_t& first, int64_t& last) const {
+    if (!data_ || size_ == 0) {
+        return false;
+    }
+    const char* start = static_cast<const char*>(data_);
+    
+    if (format_ == Format::Binary) {
+        uint64_t count = binaryHeader().recordCount;
+        if (count == 0) {
+            return false;
+        }
+        const char* records = start + sizeof(TickFileHeader);
+        std::memcpy(&first, records, sizeof(first));
+        std::memcpy(&last, records + (count - 1) * sizeof(Tick), sizeof(last));
+        return true;
+    }
+    
+    if (format_ == Format::Columnar) {
+        uint64_t blocks = columnHeader().blockCount;
+        if (blocks == 0) {
+            return false;
+        }
+        first = blockIndex(0).minTimestamp;
+        last = blockIndex(blocks - 1).maxTimestamp;
+        return true;
+    }
+    
+    // CSV: first valid line after the header, then walk back from the end
+    const char* end = start + size_;
+    const char* nl = static_cast<const char*>(memchr(start, '\n', size_));
+    const char* dataStart = nl ? nl + 1 : end;
+    
+    Tick tick;
+    bool ok = false;
+    for (const char* p = dataStart; p < end && !ok;) {
+        p = TickParser::parseNext(p, end, tick, ok);
+    }
+    if (!ok) {
+        return false;
+    }
+    first = tick.timestamp;
+    
+    const char* lineEnd = end;
+    while (lineEnd > dataStart) {
+        const char* lineStart = lineEnd;
+        while (lineStart > dataStart && lineStart[-1] != '\n') {
+            --lineStart;
+        }
+        if (TickParser::parseLine(lineStart, lineEnd, tick)) {
+            last = tick.timestamp;
+            return true;
+        }
+        lineEnd = lineStart > dataStart ? lineStart - 1 : dataStart;  // Drop the '\n'
+    }
+    last = first;
+    return true;
 }
 
 size_t MarketDataReader::approximateTickCount() const {
     if (!data_ || size_ == 0) return 0;
+    if (format_ == Format::Binary) {
+        return binaryHeader().recordCount;
+    }
+    if (format_ == Format::Columnar) {
+        return columnHeader().tickCount;
+    }
     // Rough estimate: assume average line is ~50 bytes
     return size_ / 50;
 }
 
+size_t MarketDataReader::tickCount() const {
+    if (tickCount_ != std::numeric_limits<size_t>::max()) {
+        return tickCount_;
+    }
+    
+    if (!data_ || size_ == 0) {
+        tickCount_ = 0;
+    } else if (format_ != Format::CSV) {
+        tickCount_ = approximateTickCount();  // Exact from the header
+    } else {
+        // Lines after the header, counting a final line without '\n'
+        const char* start = static_cast<const char*>(data_);
+        const char* end = start + end_;
+        const char* first = TickParser::findNewline(start, end);
+        first = first < end ? first + 1 : end;
+        tickCount_ = TickParser::countNewlines(first, end) + (first < end && end[-1] != '\n');
+    }
+    return tickCount_;
+}
+
+const TickFileHeader& MarketDataReader::binaryHeader() const {
+    return *static_cast<const TickFileHeader*>(data_);
+}
+
+const ColumnStoreHeader& MarketDataReader::columnHeader() const {
+    return *static_cast<const ColumnStoreHeader*>(data_);
+}
+
+ColumnBlockIndex MarketDataReader::blockIndex(size_t block) const {
+    ColumnBlockIndex entry;
+    const char* index = static_cast<const char*>(data_) + columnHeader().indexOffset;
+    std::memcpy(&entry, index + block * sizeof(entry), sizeof(entry));
+    return entry;
+}
+
+bool MarketDataReader::decodeNextBlock() {
+    const char* start = static_cast<const char*>(data_);
+    const double tickSize = columnHeader().tickSize;
+    
+    decoded_.clear();
+    decodedPos_ = 0;
+    if (position_ >= end_ || error_) {
+        return false;
+    }
+    
+    // Entries were checked against the file when it was opened
+    // (isColumnStore), so count is bounded by the block size
+    ColumnBlockIndex entry = blockIndex(position_++);
+    decoded_.resize(entry.count);
+    size_t n = decodeColumnBlock(start + entry.offset, entry.bytes, tickSize,
+                                 decoded_.data(), decoded_.size());
+    if (n != entry.count) {
+        // Corrupt block: end the replay here and report it
+        decoded_.clear();
+        position_ = end_;
+        error_ = EBADMSG;
+        return false;
+    }
+    return true;
+}
+
+bool MarketDataReader::verifyChecksum() const {
+    if (format_ != Format::Binary) {
+        return true;
+    }
+    const char* records = static_cast<const char*>(data_) + sizeof(TickFileHeader);
+    return tickChecksum(records, end_ - sizeof(TickFileHeader)) == binaryHeader().checksum;
+}
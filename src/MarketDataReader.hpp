@@ -1,22 +1,46 @@
 #pragma once
 
+#include "TickSource.hpp"
 #include <string>
 #include <cstdint>
 #include <memory>
 #include <functional>
+#include <vector>
 
-struct Tick {
-    int64_t timestamp;  // microseconds since epoch
-    double bid;
-    double ask;
-    int64_t volume;
+struct TickFileHeader;
+struct ColumnStoreHeader;
+struct ColumnBlockIndex;
+
+// Access hints for the file mapping. POSIX only; on Windows everything
+// except the readahead thread is ignored.
+struct MapOptions {
+    bool sequential = true;     // MADV_SEQUENTIAL: aggressive kernel readahead
+    bool willNeed = false;      // MADV_WILLNEED: start async read of the whole file
+    bool populate = false;      // MAP_POPULATE: prefault every page at open (Linux)
+    bool hugePages = false;     // MADV_HUGEPAGE: transparent hugepages where supported
+    size_t readaheadBytes = 0;  // >0: background thread touches pages this far
+                                // ahead of the parse cursor
     
-    double mid() const { return (bid + ask) / 2.0; }
+    // Comma-separated list, e.g. "populate,hugepage,readahead": random
+    // (no MADV_SEQUENTIAL), willneed, populate, hugepage and
+    // readahead[=<MiB>] (64 MiB by default). Throws std::invalid_argument
+    // for unknown items.
+    static MapOptions parse(const std::string& spec);
 };
 
-class MarketDataReader {
+class MarketDataReader final : public TickSource {
 public:
-    MarketDataReader(const std::string& filepath);
+    enum class Format {
+        CSV,      // timestamp,bid,ask,volume text
+        Binary,   // Native .atk records (see TickFile.hpp)
+        Columnar  // Compressed .atc blocks (see TickStore.hpp)
+    };
+    
+    explicit MarketDataReader(const std::string& filepath, const MapOptions& options = MapOptions());
+    
+    // Replay only ticks with from <= timestamp < to
+    MarketDataReader(const std::string& filepath, int64_t from, int64_t to,
+                     const MapOptions& options = MapOptions());
     ~MarketDataReader();
     
     // Non-copyable
@@ -28,23 +52,98 @@ public:
     MarketDataReader& operator=(MarketDataReader&&) noexcept;
     
     // Read next tick, returns false if EOF
-    bool next(Tick& tick);
+    bool next(Tick& tick) override;
+    
+    // Read up to maxTicks ticks into out, returns number read (0 at EOF)
+    size_t nextBatch(Tick* out, size_t maxTicks) override;
+    using TickSource::nextBatch;
+    
+    // Binary: view straight into the mapping. Columnar: view into the
+    // current decoded block (at most one block per call). CSV: parsed copy.
+    TickView nextView(size_t maxTicks) override;
     
-    // Reset to beginning
+    // Read all remaining ticks in file order. CSV input is split into
+    // newline-aligned chunks parsed on up to `threads` worker threads
+    // (0 = hardware concurrency); other formats are copied sequentially.
+    std::vector<Tick> readAll(unsigned threads = 0);
+    
+    // Reset to beginning (of the range, if one was given)
     void reset();
     
+    // Position at the first tick with timestamp >= the given one (and not
+    // before the range, if one was given), by binary search over the file
+    // (timestamps must be non-decreasing).
+    // Returns false if no such tick exists.
+    bool seek(int64_t timestamp);
+    
+    // Timestamps of the first and last tick in the whole file, ignoring
+    // any range and without moving the read position. Binary formats read
+    // them from the records/index; CSV parses the first and last valid
+    // lines. Returns false if the file holds no ticks.
+    bool timeBounds(int64_t& first, int64_t& last) const;
+    
     // Get total number of ticks (approximate, based on file size)
     size_t approximateTickCount() const;
     
+    // Exact number of data lines (CSV) or records in the whole file,
+    // counted once and cached. Malformed CSV lines are included, so this
+    // is an upper bound on the ticks a CSV replay returns.
+    size_t tickCount() const override;
+    
+    // True if no range was given and nothing has been read or skipped, so
+    // tickCount() is also what is left to replay
+    bool atStart() const;
+    
     // Check if file is valid
-    bool isValid() const { return data_ != nullptr && size_ > 0; }
+    bool isValid() const override { return data_ != nullptr && size_ > 0; }
+    
+    // Columnar: EBADMSG once a block fails to decode. The replay stops
+    // there rather than skipping the block.
+    int error() const override { return error_; }
+    
+    // On-disk format, detected from the file contents
+    Format format() const { return format_; }
+    
+    // Binary files: check records against the header checksum (always true otherwise)
+    bool verifyChecksum() const;
 
 private:
     void* data_;           // Memory-mapped data
     size_t size_;          // File size
-    size_t position_;      // Current read position
+    size_t position_;      // Current read position (next block for Columnar)
+    size_t origin_;        // position_ after rewind()
+    size_t end_;           // End of tick data (block count for Columnar)
+    Format format_;
     std::string filepath_;
+    int64_t startTimestamp_;  // Range passed to the constructor
+    int64_t stopTimestamp_;
+    mutable size_t tickCount_;  // Cached tickCount(), SIZE_MAX until computed
+    int error_;                 // See error()
+    
+    // Columnar: current decoded block
+    std::vector<Tick> decoded_;
+    size_t decodedPos_;
+    
+    // Background page toucher (MapOptions::readaheadBytes)
+    struct Readahead;
+    std::unique_ptr<Readahead> readahead_;
+    
+    void applyMapOptions(const MapOptions& options);
+    size_t cursorOffset() const;
+    void publishCursor();
+    void restartReadahead();  // Next pass after reset()/seek()
+    
+    bool locate(int64_t timestamp);  // seek() without the readahead restart
+    bool readTick(Tick& tick);
+    size_t readBatch(Tick* out, size_t maxTicks);
+    size_t clipToRange(const Tick* ticks, size_t n);
+    void rewind();
+    void exhaust();
     
-    bool parseLine(const char* line, size_t len, Tick& tick);
+    const TickFileHeader& binaryHeader() const;
+    const ColumnStoreHeader& columnHeader() const;
+    ColumnBlockIndex blockIndex(size_t block) const;
+    bool decodeNextBlock();
+    void unmap();
 };
 
@@ -0,0 +1,111 @@
+#include "PackedTicks.hpp"
+#include "MarketDataReader.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool fitsInt32(int64_t v) {
+    return v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max();
+}
+
+}  // namespace
+
+PackedTicks::PackedTicks(double tickSize)
+    : scale_(tickSize) {}
+
+void PackedTicks::append(const Tick& tick) {
+    if (!scale_.onGrid(tick.bid) || !scale_.onGrid(tick.ask)) {
+        throw std::invalid_argument("Price " + std::to_string(tick.bid) + "/" + std::to_string(tick.ask) +
+                                    " is not a multiple of the tick size");
+    }
+    if (tick.volume < 0 || tick.volume > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Volume " + std::to_string(tick.volume) + " does not fit a packed tick");
+    }
+    
+    PriceTicks bid = scale_.toTicks(tick.bid);
+    PriceTicks ask = scale_.toTicks(tick.ask);
+    
+    // Start a new block when full or when this tick cannot be expressed
+    // relative to the current base (clock jump, time going backwards, huge move)
+    bool newBlock = blocks_.empty() || records_.size() - blocks_.back().first >= kBlockSize;
+    if (!newBlock) {
+        const Block& block = blocks_.back();
+        newBlock = tick.timestamp < block.baseTimestamp ||
+                   static_cast<uint64_t>(tick.timestamp - block.baseTimestamp) >
+                       std::numeric_limits<uint32_t>::max() ||
+                   !fitsInt32(bid - block.basePrice) || !fitsInt32(ask - block.basePrice);
+    }
+    if (newBlock) {
+        if (!fitsInt32(ask - bid)) {
+            throw std::invalid_argument("Spread does not fit a packed tick");
+        }
+        blocks_.push_back(Block{records_.size(), tick.timestamp, bid});
+    }
+    
+    const Block& block = blocks_.back();
+    records_.push_back(PackedTick{static_cast<uint32_t>(tick.timestamp - block.baseTimestamp),
+                                  static_cast<int32_t>(bid - block.basePrice),
+                                  static_cast<int32_t>(ask - block.basePrice),
+                                  static_cast<uint32_t>(tick.volume)});
+}
+
+void PackedTicks::append(const Tick* ticks, size_t count) {
+    if (records_.capacity() < records_.size() + count) {
+        records_.reserve(std::max(records_.size() + count, records_.capacity() + records_.capacity() / 2));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        append(ticks[i]);
+    }
+}
+
+void PackedTicks::load(TickSource& source) {
+    const MarketDataReader* reader = dynamic_cast<const MarketDataReader*>(&source);
+    if (reader && reader->atStart()) {
+        reserve(size() + reader->tickCount());
+    }
+    TickView view;
+    while (!(view = source.nextView(kBlockSize)).empty()) {
+        append(view.begin(), view.size());
+    }
+    throwIfReadFailed(source, "tick source");
+}
+
+void PackedTicks::clear() {
+    records_.clear();
+    blocks_.clear();
+}
+
+size_t PackedTicks::blockOf(size_t i) const {
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), i,
+                               [](size_t index, const Block& b) { return index < b.first; });
+    return static_cast<size_t>(it - blocks_.begin()) - 1;
+}
+
+Tick PackedTicks::operator[](size_t i) const {
+    return expand(blocks_[blockOf(i)], records_[i]);
+}
+
+size_t PackedTicks::unpack(size_t first, Tick* out, size_t maxTicks) const {
+    if (first >= records_.size()) {
+        return 0;
+    }
+    size_t n = std::min(maxTicks, records_.size() - first);
+    size_t b = blockOf(first);
+    for (size_t i = 0; i < n;) {
+        const Block& block = blocks_[b];
+        size_t blockEnd = b + 1 < blocks_.size() ? blocks_[b + 1].first : records_.size();
+        size_t stop = std::min(first + n, blockEnd);
+        for (size_t r = first + i; r < stop; ++r, ++i) {
+            out[i] = expand(block, records_[r]);
+        }
+        ++b;
+    }
+    return n;
+}
+
+size_t PackedTicks::memoryBytes() const {
+    return records_.capacity() * sizeof(PackedTick) + blocks_.capacity() * sizeof(Block);
+}
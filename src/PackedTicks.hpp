@@ -0,0 +1,98 @@
+#pragma once
+
+#include "TickSource.hpp"
+#include "Price.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// 16-byte in-memory tick record: offsets from its block's base
+struct PackedTick {
+    uint32_t timeDelta;  // microseconds after Block::baseTimestamp
+    int32_t bid;         // ticks from Block::basePrice
+    int32_t ask;
+    uint32_t volume;
+};
+
+static_assert(sizeof(PackedTick) == 16, "PackedTick must stay 16 bytes");
+
+// Compact in-RAM tick store for repeated sweeps over the same data (half
+// the size of Tick). Ticks are packed on append and expanded back to Tick
+// on access; prices must lie on the tick grid, as for the .atc writer.
+//
+// A new block (base timestamp + base price) starts every kBlockSize ticks,
+// or earlier when a delta or offset would not fit in 32 bits.
+class PackedTicks {
+public:
+    static constexpr size_t kBlockSize = 4096;
+    
+    explicit PackedTicks(double tickSize = 0.25);
+    
+    // Throws std::invalid_argument for off-grid prices and volumes outside
+    // [0, 2^32)
+    void append(const Tick& tick);
+    void append(const Tick* ticks, size_t count);
+    
+    // Append everything remaining in source. Reserves tickCount() up front
+    // only for an unranged MarketDataReader that has not been read yet;
+    // other sources (ranges, session filters, datasets, partly consumed
+    // readers) report whole-file counts, so the store grows as it goes.
+    void load(TickSource& source);
+    
+    size_t size() const { return records_.size(); }
+    bool empty() const { return records_.empty(); }
+    void clear();
+    void reserve(size_t ticks) { records_.reserve(ticks); }
+    
+    // Expand tick i
+    Tick operator[](size_t i) const;
+    
+    // Expand up to maxTicks ticks starting at first into out, returns count
+    size_t unpack(size_t first, Tick* out, size_t maxTicks) const;
+    
+    // Bytes held, records plus block headers
+    size_t memoryBytes() const;
+    
+    double tickSize() const { return scale_.tickSize(); }
+
+private:
+    struct Block {
+        size_t first;           // Index of the block's first record
+        int64_t baseTimestamp;
+        PriceTicks basePrice;
+    };
+    
+    PriceScale scale_;
+    std::vector<PackedTick> records_;
+    std::vector<Block> blocks_;
+    
+    size_t blockOf(size_t i) const;
+    Tick expand(const Block& block, const PackedTick& record) const {
+        return Tick{block.baseTimestamp + record.timeDelta, scale_.toPrice(block.basePrice + record.bid),
+                    scale_.toPrice(block.basePrice + record.ask), static_cast<int64_t>(record.volume)};
+    }
+};
+
+// Replays a PackedTicks store as a TickSource; the store must outlive it
+class PackedTickReader final : public TickSource {
+public:
+    explicit PackedTickReader(const PackedTicks& ticks) : ticks_(ticks), position_(0) {}
+    
+    using TickSource::nextBatch;
+    bool next(Tick& tick) override { return nextBatch(&tick, 1) == 1; }
+    size_t nextBatch(Tick* out, size_t maxTicks) override {
+        size_t n = ticks_.unpack(position_, out, maxTicks);
+        position_ += n;
+        return n;
+    }
+    
+    size_t tickCount() const override { return ticks_.size(); }
+    bool isValid() const override { return true; }
+    
+    // Back to the first tick, for the next sweep
+    void reset() { position_ = 0; }
+
+private:
+    const PackedTicks& ticks_;
+    size_t position_;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+// Price as an integer number of minimum increments (e.g. ES quarter
+// points). Fills and PnL on this grid are exact. Parsing stays in
+// floating point; prices move to the grid when a trade is filled or a
+// tick is stored, and back to decimal for reporting.
+using PriceTicks = int64_t;
+
+class PriceScale {
+public:
+    // Throws std::invalid_argument unless tickSize is positive and finite
+    explicit PriceScale(double tickSize = 0.25)
+        : tickSize_(checkTickSize(tickSize)),
+          perPoint_(std::round(1.0 / tickSize)),
+          integral_(std::fabs(perPoint_ * tickSize - 1.0) < 1e-12) {}
+    
+    double tickSize() const { return tickSize_; }
+    
+    // Nearest tick
+    PriceTicks toTicks(double price) const {
+        return static_cast<PriceTicks>(std::round(price / tickSize_));
+    }
+    
+    // True if price lies on the grid (within rounding of its decimal form)
+    bool onGrid(double price) const {
+        return std::fabs(static_cast<double>(toTicks(price)) * tickSize_ - price) <= tickSize_ * 1e-6;
+    }
+    
+    // Divides by an integral ticks-per-point where possible, so 18001 ticks
+    // come back as exactly the double the parser produces for "4500.25"
+    double toPrice(PriceTicks ticks) const {
+        double t = static_cast<double>(ticks);
+        return integral_ ? t / perPoint_ : t * tickSize_;
+    }
+
+private:
+    static double checkTickSize(double tickSize) {
+        if (!(tickSize > 0.0) || !std::isfinite(tickSize)) {
+            throw std::invalid_argument("Tick size must be positive and finite");
+        }
+        return tickSize;
+    }
+    
+    double tickSize_;
+    double perPoint_;
+    bool integral_;
+};
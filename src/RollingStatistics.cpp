@@ -2,6 +2,8 @@
 #include <cstdlib>
 #include <algorithm>
 #include <cstring>
+#include <new>
+#include <stdexcept>
 #ifdef __AVX2__
 #include <immintrin.h>
 #endif
@@ -11,19 +13,36 @@
 #include <stdlib.h>  // For posix_memalign
 #endif
 
-RollingStatistics::RollingStatistics(size_t windowSize)
+template<typename Policy>
+BasicRollingStatistics<Policy>::BasicRollingStatistics(size_t windowSize, StatisticsMode mode)
     : windowSize_(windowSize),
+      mode_(mode),
       buffer_(nullptr),
-      writeIndex_(0),
+      mask_(0),
       count_(0),
       alpha_(2.0 / (windowSize + 1.0)),  // EWMA decay factor
       mean_(0.0),
       variance_(0.0),
-      m2_(0.0) {
+      m2_(0.0),
+      shift_(0.0),
+      timestamp_(0) {
+    if (windowSize == 0) {
+        throw std::invalid_argument("RollingStatistics window must be positive");
+    }
+    
+    // EWMA keeps no history
+    if (mode != StatisticsMode::Sliding) {
+        return;
+    }
     
-    // Align buffer for SIMD
-    size_t alignedSize = (windowSize + 7) & ~7;  // Align to 8
-    size_t totalSize = alignedSize * sizeof(double);
+    // Round up to a power of two so the slot is a mask, not a modulo.
+    // Spare slots are never read: eviction looks back exactly windowSize.
+    size_t capacity = 8;
+    while (capacity < windowSize) {
+        capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    size_t totalSize = capacity * sizeof(double);
     
 #ifdef _WIN32
     // Windows: use _aligned_malloc
@@ -43,12 +62,14 @@ RollingStatistics::RollingStatistics(size_t windowSize)
     #endif
 #endif
     
-    if (buffer_) {
-        std::memset(buffer_, 0, totalSize);
+    if (!buffer_) {
+        throw std::bad_alloc();
     }
+    std::memset(buffer_, 0, totalSize);
 }
 
-RollingStatistics::~RollingStatistics() {
+template<typename Policy>
+BasicRollingStatistics<Policy>::~BasicRollingStatistics() {
     if (buffer_) {
 #ifdef _WIN32
         _aligned_free(buffer_);
@@ -59,14 +80,25 @@ RollingStatistics::~RollingStatistics() {
     }
 }
 
-void RollingStatistics::update(double value) {
-    size_t idx = writeIndex_.fetch_add(1, std::memory_order_acq_rel) % windowSize_;
-    size_t oldCount = count_.fetch_add(1, std::memory_order_acq_rel);
-    
-    double oldValue = buffer_[idx];
-    buffer_[idx] = value;
+template<typename Policy>
+void BasicRollingStatistics<Policy>::reset() {
+    Policy::store(count_, 0);
+    mean_ = 0.0;
+    variance_ = 0.0;
+    m2_ = 0.0;
+    timestamp_ = 0;
+    if constexpr (Policy::kPublishes) {
+        published_.store(StatisticsSnapshot());
+    }
+}
+
+template<typename Policy>
+void BasicRollingStatistics<Policy>::update(double value, int64_t timestamp) {
+    size_t oldCount = Policy::load(count_);
     
-    if (oldCount < windowSize_) {
+    if (mode_ == StatisticsMode::Sliding) {
+        updateSliding(value, oldCount);
+    } else if (oldCount < windowSize_) {
         // Initial fill phase
         if (oldCount == 0) {
             mean_ = value;
@@ -84,19 +116,49 @@ void RollingStatistics::update(double value) {
         // Rolling window: update EWMA
         updateEWMA(value);
     }
+    
+    // Publish after the state it counts
+    timestamp_ = timestamp;
+    Policy::store(count_, oldCount + 1);
+    if constexpr (Policy::kPublishes) {
+        published_.store(StatisticsSnapshot{mean_, variance_, oldCount + 1, timestamp});
+    }
 }
 
-void RollingStatistics::updateEWMA(double value) {
+template<typename Policy>
+void BasicRollingStatistics<Policy>::updateSliding(double value, size_t oldCount) {
+    if (oldCount == 0) {
+        shift_ = value;
+        sum_ = CompensatedSum<>();
+        sumSquares_ = CompensatedSum<>();
+    }
+    
+    // Evict the value added a full window ago
+    if (oldCount >= windowSize_) {
+        double old = buffer_[(oldCount - windowSize_) & mask_] - shift_;
+        sum_.add(-old);
+        sumSquares_.add(-old * old);
+    }
+    buffer_[oldCount & mask_] = value;
+    
+    double d = value - shift_;
+    sum_.add(d);
+    sumSquares_.add(d * d);
+    
+    double n = static_cast<double>(std::min(oldCount + 1, windowSize_));
+    double sum = sum_.value();
+    mean_ = shift_ + sum / n;
+    variance_ = std::max(0.0, (sumSquares_.value() - sum * sum / n) / n);
+}
+
+template<typename Policy>
+void BasicRollingStatistics<Policy>::updateEWMA(double value) {
     // EWMA update for mean
     double oldMean = mean_;
     mean_ = alpha_ * value + (1.0 - alpha_) * mean_;
     
-    // Update variance using exponential weighted variance
-    // Simplified approach: update based on new and old means
-    double delta = value - oldMean;
-    double deltaMean = mean_ - oldMean;
-    
     // Exponential weighted variance approximation
+    double delta = value - oldMean;
     variance_ = (1.0 - alpha_) * (variance_ + alpha_ * delta * delta);
     
     // Ensure variance is non-negative
@@ -105,3 +167,5 @@ void RollingStatistics::updateEWMA(double value) {
     }
 }
 
+template class BasicRollingStatistics<SingleThreaded>;
+template class BasicRollingStatistics<ThreadSafe>;
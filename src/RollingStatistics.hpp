@@ -1,26 +1,142 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <atomic>
 #include <cmath>
 #include <cstring>
-#ifdef __AVX2__
-#include <immintrin.h>  // For SIMD
+#include <type_traits>
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>  // For SIMD and _mm_pause
 #endif
 
-class RollingStatistics {
+// How statistics evolve once the window has filled
+enum class StatisticsMode {
+    Ewma,    // Exponentially weighted, alpha = 2 / (window + 1); no history kept
+    Sliding  // Exact mean/variance of the last `window` values (ring buffer)
+};
+
+// Neumaier-compensated running sum: the rounding error of every add is
+// carried separately, so adding and later subtracting the same values
+// does not drift
+template<typename Real = double>
+struct CompensatedSum {
+    Real sum = 0;
+    Real compensation = 0;
+    
+    void add(Real x) {
+        Real t = sum + x;
+        if (std::fabs(sum) >= std::fabs(x)) {
+            compensation += (sum - t) + x;
+        } else {
+            compensation += (x - t) + sum;
+        }
+        sum = t;
+    }
+    Real value() const { return sum + compensation; }
+};
+
+// Consistent view of the statistics after one update
+struct StatisticsSnapshot {
+    double mean = 0.0;
+    double variance = 0.0;
+    size_t count = 0;
+    int64_t timestamp = 0;  // As passed to update with the last value
+};
+
+// Single-writer seqlock holding the latest StatisticsSnapshot. The writer
+// never waits: it bumps the sequence to odd, stores the fields and bumps
+// it to even. Readers retry until they copy the fields between two equal,
+// even sequence values. Fields are relaxed atomics so the racy copy is
+// well-defined; on x86 both sides compile to plain moves.
+class SnapshotSeqlock {
+public:
+    void store(const StatisticsSnapshot& snapshot) {
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mean_.store(snapshot.mean, std::memory_order_relaxed);
+        variance_.store(snapshot.variance, std::memory_order_relaxed);
+        count_.store(snapshot.count, std::memory_order_relaxed);
+        timestamp_.store(snapshot.timestamp, std::memory_order_relaxed);
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+    
+    // Single attempt; false if a write was in progress or overlapped
+    bool tryLoad(StatisticsSnapshot& out) const {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        out.mean = mean_.load(std::memory_order_relaxed);
+        out.variance = variance_.load(std::memory_order_relaxed);
+        out.count = count_.load(std::memory_order_relaxed);
+        out.timestamp = timestamp_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+    
+    // Spins until a consistent copy is read (a few retries at most, since
+    // each write is a handful of stores)
+    StatisticsSnapshot load() const {
+        StatisticsSnapshot snapshot;
+        while (!tryLoad(snapshot)) {
+#if defined(__SSE2__) || defined(_M_X64)
+            _mm_pause();
+#endif
+        }
+        return snapshot;
+    }
+
+private:
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<double> mean_{0.0};
+    std::atomic<double> variance_{0.0};
+    std::atomic<size_t> count_{0};
+    std::atomic<int64_t> timestamp_{0};
+};
+
+// Counter policies. Only ThreadSafe shares state with readers on other
+// threads; everything else is owned by the single writer.
+
+// Backtest engine: plain counter, no read-modify-write per tick
+struct SingleThreaded {
+    static constexpr bool kPublishes = false;
+    using Counter = size_t;
+    static size_t load(const Counter& c) { return c; }
+    static void store(Counter& c, size_t value) { c = value; }
+};
+
+// One writer publishing to readers on other threads: each update stores a
+// StatisticsSnapshot in a seqlock, and the count is stored with release,
+// so a reader that sees count n also sees the n-th value's buffer slot.
+// Still no fetch_add, since only the writer increments.
+struct ThreadSafe {
+    static constexpr bool kPublishes = true;
+    using Counter = std::atomic<size_t>;
+    static size_t load(const Counter& c) { return c.load(std::memory_order_acquire); }
+    static void store(Counter& c, size_t value) { c.store(value, std::memory_order_release); }
+};
+
+template<typename Policy>
+class BasicRollingStatistics {
 public:
-    explicit RollingStatistics(size_t windowSize = 20000);
-    ~RollingStatistics();
+    // Throws std::invalid_argument if windowSize is zero
+    explicit BasicRollingStatistics(size_t windowSize = 20000, StatisticsMode mode = StatisticsMode::Ewma);
+    ~BasicRollingStatistics();
     
     // Non-copyable
-    RollingStatistics(const RollingStatistics&) = delete;
-    RollingStatistics& operator=(const RollingStatistics&) = delete;
+    BasicRollingStatistics(const BasicRollingStatistics&) = delete;
+    BasicRollingStatistics& operator=(const BasicRollingStatistics&) = delete;
     
-    // Update with new value (lock-free, O(1))
-    void update(double value);
+    // Update with new value (O(1), single writer). timestamp is only
+    // carried into the snapshot.
+    void update(double value, int64_t timestamp = 0);
     
-    // Get current statistics
+    // Forget all values, as if newly constructed
+    void reset();
+    
+    // Get current statistics (writer thread only)
     double mean() const { return mean_; }
     double variance() const { return variance_; }
     double stddev() const { return std::sqrt(variance_); }
@@ -30,16 +146,32 @@ public:
     }
     
     // Get number of values processed
-    size_t count() const { return count_.load(std::memory_order_acquire); }
+    size_t count() const { return Policy::load(count_); }
     
     // Check if enough data for valid statistics
     bool isReady() const { return count() >= windowSize_; }
+    
+    StatisticsMode mode() const { return mode_; }
+    
+    // Mean, variance, count and timestamp from the same update. Safe from
+    // any thread for ConcurrentRollingStatistics, and never blocks the
+    // writer; the writer thread only for RollingStatistics.
+    StatisticsSnapshot snapshot() const {
+        if constexpr (Policy::kPublishes) {
+            return published_.load();
+        } else {
+            return StatisticsSnapshot{mean_, variance_, count_, timestamp_};
+        }
+    }
 
 private:
+    struct Unpublished {};
+    
     const size_t windowSize_;
-    double* buffer_;           // Ring buffer
-    std::atomic<size_t> writeIndex_;
-    std::atomic<size_t> count_;
+    const StatisticsMode mode_;
+    double* buffer_;           // Ring buffer (Sliding mode only), power-of-two
+    size_t mask_;              // capacity - 1, so slots are count & mask_
+    typename Policy::Counter count_;
     
     // EWMA parameters
     double alpha_;             // Decay factor
@@ -47,7 +179,22 @@ private:
     double variance_;
     double m2_;                // Second moment for variance calculation
     
-    // Lock-free update
+    // Sliding mode: sums of (value - shift_) over the window. Shifting by
+    // the first value keeps the sum of squares small relative to the
+    // variance, so mean/variance from the sums stay accurate.
+    double shift_;
+    CompensatedSum<> sum_;
+    CompensatedSum<> sumSquares_;
+    
+    int64_t timestamp_;        // Of the last value
+    std::conditional_t<Policy::kPublishes, SnapshotSeqlock, Unpublished> published_;
+    
     void updateEWMA(double value);
+    void updateSliding(double value, size_t oldCount);
 };
 
+// Backtest engine and feature builds
+using RollingStatistics = BasicRollingStatistics<SingleThreaded>;
+
+// Statistics read live from other threads
+using ConcurrentRollingStatistics = BasicRollingStatistics<ThreadSafe>;
@@ -0,0 +1,276 @@
+#include "SessionCalendar.hpp"
+#include "MarketDataReader.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kMicrosPerMinute = 60000000LL;
+constexpr int64_t kMicrosPerDay = 1440 * kMicrosPerMinute;
+
+int64_t floorDiv(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// Proleptic Gregorian date <-> days since 1970-01-01
+int64_t daysFromCivil(int64_t y, int m, int d) {
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+int64_t yearOf(int64_t days) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    return yoe + era * 400 + (mp >= 10);  // Jan/Feb belong to the next civil year
+}
+
+// 0 = Sunday
+int weekday(int64_t days) {
+    return static_cast<int>(((days + 4) % 7 + 7) % 7);
+}
+
+// First Sunday on or after day
+int64_t sundayFrom(int64_t day) {
+    return day + (7 - weekday(day)) % 7;
+}
+
+bool usDstActive(int64_t day, int minute) {
+    int64_t year = yearOf(day);
+    int64_t start = sundayFrom(daysFromCivil(year, 3, 1)) + 7;  // Second Sunday of March
+    int64_t end = sundayFrom(daysFromCivil(year, 11, 1));       // First Sunday of November
+    bool afterStart = day > start || (day == start && minute >= 120);
+    bool beforeEnd = day < end || (day == end && minute < 120);
+    return afterStart && beforeEnd;
+}
+
+int64_t dayFromDate(int date) {
+    return daysFromCivil(date / 10000, date / 100 % 100, date % 100);
+}
+
+int parseMinute(const std::string& text) {
+    int h, m;
+    char colon;
+    std::istringstream in(text);
+    if (!(in >> h >> colon >> m) || colon != ':' || h < 0 || h > 24 || m < 0 || m > 59) {
+        throw std::runtime_error("Invalid time of day: " + text);
+    }
+    return h * 60 + m;
+}
+
+int parseDate(const std::string& text) {
+    int y, m, d;
+    char dash1, dash2;
+    std::istringstream in(text);
+    if (!(in >> y >> dash1 >> m >> dash2 >> d) || dash1 != '-' || dash2 != '-' ||
+        m < 1 || m > 12 || d < 1 || d > 31) {
+        throw std::runtime_error("Invalid date: " + text);
+    }
+    return y * 10000 + m * 100 + d;
+}
+
+TimeZone parseZone(const std::string& text) {
+    if (text == "America/New_York") {
+        return TimeZone::newYork();
+    }
+    if (text == "America/Chicago") {
+        return TimeZone{-360, true};
+    }
+    if (text == "UTC") {
+        return TimeZone::utc();
+    }
+    if (text.size() > 1 && (text[0] == '+' || text[0] == '-')) {
+        int minutes = parseMinute(text.substr(1));
+        return TimeZone{text[0] == '-' ? -minutes : minutes, false};
+    }
+    throw std::runtime_error("Unknown time zone: " + text);
+}
+
+}  // namespace
+
+SessionCalendar::SessionCalendar(int openMinute, int closeMinute, const TimeZone& zone)
+    : openMinute_(openMinute), closeMinute_(closeMinute), zone_(zone) {
+    if (openMinute < 0 || openMinute > 1440 || closeMinute < 0 || closeMinute > 1440 ||
+        openMinute == closeMinute) {
+        throw std::invalid_argument("Invalid session hours");
+    }
+}
+
+SessionCalendar SessionCalendar::rth() {
+    return SessionCalendar(9 * 60 + 30, 16 * 60);
+}
+
+SessionCalendar SessionCalendar::eth() {
+    return SessionCalendar(18 * 60, 17 * 60);
+}
+
+SessionCalendar SessionCalendar::fromSpec(const std::string& spec) {
+    if (spec == "rth") {
+        return rth();
+    }
+    if (spec == "eth") {
+        return eth();
+    }
+    return fromFile(spec);
+}
+
+SessionCalendar SessionCalendar::fromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open session calendar: " + path);
+    }
+    
+    TimeZone zone = TimeZone::newYork();
+    int open = -1;
+    int close = -1;
+    std::vector<int> holidays;
+    std::vector<std::pair<int, int>> earlyCloses;
+    
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string directive, a, b;
+        if (!(fields >> directive)) {
+            continue;
+        }
+        fields >> a >> b;
+        if (directive == "timezone" && !a.empty()) {
+            zone = parseZone(a);
+        } else if (directive == "hours" && !b.empty()) {
+            open = parseMinute(a);
+            close = parseMinute(b);
+        } else if (directive == "holiday" && !a.empty()) {
+            holidays.push_back(parseDate(a));
+        } else if (directive == "early_close" && !b.empty()) {
+            earlyCloses.emplace_back(parseDate(a), parseMinute(b));
+        } else {
+            throw std::runtime_error("Invalid session calendar line in " + path + ": " + line);
+        }
+    }
+    if (open < 0) {
+        throw std::runtime_error("Session calendar has no hours: " + path);
+    }
+    
+    SessionCalendar calendar(open, close, zone);
+    for (int date : holidays) {
+        calendar.addHoliday(date);
+    }
+    for (const auto& early : earlyCloses) {
+        calendar.addEarlyClose(early.first, early.second);
+    }
+    return calendar;
+}
+
+void SessionCalendar::addHoliday(int date) {
+    holidays_.insert(dayFromDate(date));
+}
+
+void SessionCalendar::addEarlyClose(int date, int closeMinute) {
+    earlyCloses_[dayFromDate(date)] = closeMinute;
+}
+
+int64_t SessionCalendar::toUtc(int64_t day, int minute) const {
+    int offset = zone_.utcOffsetMinutes + (zone_.usDst && usDstActive(day, minute) ? 60 : 0);
+    return (day * 1440 + minute - offset) * kMicrosPerMinute;
+}
+
+bool SessionCalendar::sessionAt(int64_t timestamp, int64_t& open, int64_t& close) const {
+    // Local dates lag or lead UTC by under a day, so start one day early
+    int64_t first = floorDiv(timestamp, kMicrosPerDay) - 1;
+    for (int64_t day = first; day < first + 370; ++day) {
+        int wd = weekday(day);
+        if (wd == 0 || wd == 6 || holidays_.count(day)) {
+            continue;
+        }
+        auto early = earlyCloses_.find(day);
+        close = toUtc(day, early != earlyCloses_.end() ? early->second : closeMinute_);
+        open = toUtc(openMinute_ < closeMinute_ ? day : day - 1, openMinute_);
+        if (close > timestamp) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SessionCalendar::contains(int64_t timestamp) const {
+    int64_t open, close;
+    return sessionAt(timestamp, open, close) && timestamp >= open;
+}
+
+SessionFilter::SessionFilter(TickSource& source, const SessionCalendar& calendar)
+    : source_(source),
+      seekable_(dynamic_cast<MarketDataReader*>(&source)),
+      calendar_(calendar),
+      open_(std::numeric_limits<int64_t>::min()),
+      close_(std::numeric_limits<int64_t>::min()),
+      seekTo_(std::numeric_limits<int64_t>::min()),
+      highWater_(std::numeric_limits<int64_t>::min()),
+      done_(false) {}
+
+TickView SessionFilter::nextView(size_t maxTicks) {
+    while (!done_) {
+        if (pending_.empty()) {
+            if (seekTo_ != std::numeric_limits<int64_t>::min()) {
+                seekable_->seek(seekTo_);
+                highWater_ = std::max(highWater_, seekTo_);
+                seekTo_ = std::numeric_limits<int64_t>::min();
+            }
+            pending_ = source_.nextView(maxTicks);
+            if (pending_.empty()) {
+                done_ = true;
+                break;
+            }
+            highWater_ = std::max(highWater_, pending_.end()[-1].timestamp);
+        }
+        
+        const Tick* first = pending_.begin();
+        if (first->timestamp >= close_ && !calendar_.sessionAt(first->timestamp, open_, close_)) {
+            done_ = true;  // No further sessions
+            break;
+        }
+        
+        if (first->timestamp < open_) {
+            // Closed hours: jump straight to the open where possible. Only
+            // forward: a tick behind the reader (a backward timestamp) would
+            // otherwise seek back to the same open forever.
+            if (seekable_ && open_ > highWater_) {
+                seekTo_ = open_;
+                pending_ = TickView{};
+            } else {
+                pending_.first = std::find_if(pending_.begin(), pending_.end(),
+                                              [this](const Tick& t) { return t.timestamp >= open_; });
+            }
+            continue;
+        }
+        
+        // The view ends at the first tick outside the session, so ticks
+        // out of order inside a batch are filtered too
+        const Tick* last = pending_.begin() + std::min(maxTicks, pending_.size());
+        last = std::find_if(first + 1, last, [this](const Tick& t) {
+            return t.timestamp < open_ || t.timestamp >= close_;
+        });
+        pending_.first = last;
+        return TickView{first, last};
+    }
+    return TickView{};
+}
+
+size_t SessionFilter::nextBatch(Tick* out, size_t maxTicks) {
+    TickView view = nextView(maxTicks);
+    std::copy(view.begin(), view.end(), out);
+    return view.size();
+}
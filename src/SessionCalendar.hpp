@@ -0,0 +1,103 @@
+#pragma once
+
+#include "TickSource.hpp"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+
+class MarketDataReader;
+
+// Exchange clock for converting local session times to UTC timestamps
+struct TimeZone {
+    int utcOffsetMinutes = 0;  // Standard time, e.g. -300 for New York
+    bool usDst = false;        // +1 h from the second Sunday of March to the first Sunday of November
+    
+    static TimeZone utc() { return TimeZone{0, false}; }
+    static TimeZone newYork() { return TimeZone{-300, true}; }
+};
+
+// Trading sessions: daily hours on weekdays, minus holidays, with early
+// closes. A session belongs to the local date it closes on; when open is
+// after close (e.g. 18:00-17:00) it starts the previous evening.
+//
+// Calendar files hold one directive per line ('#' starts a comment):
+//   timezone America/New_York     (America/Chicago, UTC or a fixed offset like -05:00)
+//   hours 09:30 16:00
+//   holiday 2024-07-04
+//   early_close 2024-11-29 13:00
+class SessionCalendar {
+public:
+    // Hours as minutes after local midnight
+    SessionCalendar(int openMinute, int closeMinute, const TimeZone& zone = TimeZone::newYork());
+    
+    // CME equity index futures: regular (09:30-16:00 ET) and electronic
+    // (18:00-17:00 ET) hours, with no holidays loaded
+    static SessionCalendar rth();
+    static SessionCalendar eth();
+    
+    // "rth", "eth" or a calendar file. Throws std::runtime_error on a bad file.
+    static SessionCalendar fromSpec(const std::string& spec);
+    static SessionCalendar fromFile(const std::string& path);
+    
+    // Dates as yyyymmdd
+    void addHoliday(int date);
+    void addEarlyClose(int date, int closeMinute);
+    
+    // True if timestamp falls inside a session
+    bool contains(int64_t timestamp) const;
+    
+    // First session that has not closed by timestamp, as [open, close) in
+    // microseconds since epoch. False if none starts within a year.
+    bool sessionAt(int64_t timestamp, int64_t& open, int64_t& close) const;
+
+private:
+    int openMinute_;
+    int closeMinute_;
+    TimeZone zone_;
+    std::set<int64_t> holidays_;            // Days since epoch
+    std::map<int64_t, int> earlyCloses_;    // Days since epoch -> close minute
+    
+    int64_t toUtc(int64_t day, int minute) const;
+};
+
+// What a strategy keeps across the closed hours between sessions
+enum class SessionBoundary {
+    Carry,  // Statistics and open positions carry over (warm start)
+    Reset   // Flatten at the session's last tick; the next session starts cold
+};
+
+// Replays only the ticks inside calendar sessions. Seekable sources (a
+// MarketDataReader) jump over closed hours with seek(), so excluded ticks
+// are never parsed or decoded; other sources are filtered tick by tick.
+// A returned view never spans two sessions. Ticks outside the current
+// session are dropped wherever they sit, including backward timestamps.
+class SessionFilter final : public TickSource {
+public:
+    // source and calendar must outlive the filter
+    SessionFilter(TickSource& source, const SessionCalendar& calendar);
+    
+    bool next(Tick& tick) override { return nextBatch(&tick, 1) == 1; }
+    size_t nextBatch(Tick* out, size_t maxTicks) override;
+    using TickSource::nextBatch;
+    TickView nextView(size_t maxTicks) override;
+    
+    size_t tickCount() const override { return source_.tickCount(); }
+    bool isValid() const override { return source_.isValid(); }
+    int error() const override { return source_.error(); }
+    
+    // Close time of the session the last returned ticks belong to; changes
+    // exactly at session boundaries
+    int64_t sessionClose() const { return close_; }
+
+private:
+    TickSource& source_;
+    MarketDataReader* seekable_;
+    const SessionCalendar& calendar_;
+    TickView pending_;   // Fetched from source_, not yet returned
+    int64_t open_;       // Current session [open_, close_)
+    int64_t close_;
+    int64_t seekTo_;     // Seek before the next fetch, if > min
+    int64_t highWater_;  // Latest timestamp fetched or sought; seeks only go past it
+    bool done_;
+};
@@ -7,12 +7,7 @@ SignalGenerator::SignalGenerator(double threshold)
       lastZScore_(0.0) {
 }
 
-Signal SignalGenerator::generate(double price, const RollingStatistics& stats) {
-    if (!stats.isReady()) {
-        return Signal::FLAT;
-    }
-    
-    double zscore = stats.zscore(price);
+Signal SignalGenerator::generateFromZScore(double zscore) {
     lastZScore_ = zscore;
     
     // Current state machine logic:
@@ -12,8 +12,26 @@ class SignalGenerator {
 public:
     explicit SignalGenerator(double threshold = 2.5);
     
-    // Generate signal based on current z-score
-    Signal generate(double price, const RollingStatistics& stats);
+    // Generate signal based on current z-score. Stats is RollingStatistics
+    // or a FixedRollingStatistics; inlined so the tick loop has no call
+    // into the statistics.
+    template<typename Stats>
+    Signal generate(double price, const Stats& stats) {
+        if (!stats.isReady()) {
+            return Signal::FLAT;
+        }
+        
+        return generateFromZScore(stats.zscore(price));
+    }
+    
+    // Same state machine for a precomputed z-score (statistics already warm)
+    Signal generateFromZScore(double zscore);
+    
+    // Back to FLAT, e.g. after the position was closed externally
+    void reset() {
+        currentSignal_ = Signal::FLAT;
+        lastZScore_ = 0.0;
+    }
     
     // Get current signal
     Signal currentSignal() const { return currentSignal_; }
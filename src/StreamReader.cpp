@@ -0,0 +1,150 @@
+#include "StreamReader.hpp"
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+StreamReader::StreamReader(const std::string& path, size_t bufferSize)
+    : fd_(-1),
+      ownsFd_(false),
+      bufferSize_(bufferSize),
+      nextBuffer_(0),
+      stop_(false) {
+    
+#ifdef _WIN32
+    if (path == "-") {
+        fd_ = 0;
+        _setmode(fd_, _O_BINARY);
+    } else {
+        fd_ = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+        ownsFd_ = true;
+    }
+#else
+    if (path == "-") {
+        fd_ = STDIN_FILENO;
+    } else {
+        fd_ = open(path.c_str(), O_RDONLY);
+        ownsFd_ = true;
+    }
+#endif
+    
+    if (fd_ < 0) {
+        return;
+    }
+    
+    for (Buffer& b : buffers_) {
+        b.storage.resize(kMaxLineLength + bufferSize_);
+        b.chunk.data = b.storage.data() + kMaxLineLength;
+    }
+    reader_ = std::thread(&StreamReader::readLoop, this);
+}
+
+StreamReader::~StreamReader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true);
+    }
+    cv_.notify_all();
+    if (reader_.joinable()) {
+        reader_.join();
+    }
+    
+    if (ownsFd_ && fd_ >= 0) {
+#ifdef _WIN32
+        _close(fd_);
+#else
+        close(fd_);
+#endif
+    }
+}
+
+void StreamReader::readLoop() {
+    int index = 0;
+    while (true) {
+        Buffer& buffer = buffers_[index];
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&]() { return !buffer.full || stop_.load(); });
+            if (stop_.load()) {
+                return;
+            }
+        }
+        
+        char* data = buffer.chunk.data;
+        size_t length = 0;
+        bool eof = false;
+        int error = 0;
+        while (length < bufferSize_) {
+#ifndef _WIN32
+            // Wake up periodically so the destructor never waits on a silent pipe
+            pollfd pfd{fd_, POLLIN, 0};
+            if (poll(&pfd, 1, 100) == 0) {
+                if (stop_.load()) {
+                    return;
+                }
+                continue;
+            }
+            ssize_t r = read(fd_, data + length, bufferSize_ - length);
+#else
+            int r = _read(fd_, data + length, static_cast<unsigned>(bufferSize_ - length));
+#endif
+            if (r > 0) {
+                length += static_cast<size_t>(r);
+            } else if (r < 0 && errno == EINTR) {
+                continue;
+            } else {
+                // EOF or read error ends the stream; errors are reported
+                // through error() rather than passing for a clean end
+                eof = true;
+                error = r < 0 ? errno : 0;
+                break;
+            }
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer.chunk.length = length;
+            buffer.chunk.eof = eof;
+            buffer.chunk.error = error;
+            buffer.full = true;
+        }
+        cv_.notify_all();
+        
+        if (eof) {
+            return;
+        }
+        index ^= 1;
+    }
+}
+
+ChunkedCsvReader::Chunk* StreamReader::acquire() {
+    if (fd_ < 0) {
+        return nullptr;
+    }
+    
+    Buffer& buffer = buffers_[nextBuffer_];
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return buffer.full; });
+    }
+    nextBuffer_ ^= 1;
+    return &buffer.chunk;
+}
+
+void StreamReader::release(Chunk* chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Buffer& b : buffers_) {
+            if (&b.chunk == chunk) {
+                b.full = false;
+            }
+        }
+    }
+    cv_.notify_all();
+}
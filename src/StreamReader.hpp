@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ChunkedCsvReader.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// CSV tick reader for inputs that cannot be mapped: stdin ("-"), pipes and
+// FIFOs (e.g. `zstdcat day.csv.zst | artemis -`).
+//
+// A reader thread fills one of two fixed buffers with read() while the
+// caller parses the other, so decompression and parsing overlap and memory
+// stays bounded at 2 * bufferSize.
+class StreamReader : public ChunkedCsvReader {
+public:
+    static constexpr size_t kDefaultBufferSize = 4 << 20;
+
+    explicit StreamReader(const std::string& path, size_t bufferSize = kDefaultBufferSize);
+    ~StreamReader() override;
+
+    // Non-copyable
+    StreamReader(const StreamReader&) = delete;
+    StreamReader& operator=(const StreamReader&) = delete;
+
+    bool isValid() const override { return fd_ >= 0; }
+
+protected:
+    Chunk* acquire() override;
+    void release(Chunk* chunk) override;
+
+private:
+    struct Buffer {
+        std::vector<char> storage;  // kMaxLineLength headroom + bufferSize data
+        Chunk chunk;
+        bool full = false;          // Filled by the reader, not yet consumed
+    };
+
+    int fd_;
+    bool ownsFd_;
+    size_t bufferSize_;
+    Buffer buffers_[2];
+    int nextBuffer_;                // Next buffer handed to the parser
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> stop_;
+    std::thread reader_;
+
+    void readLoop();
+};
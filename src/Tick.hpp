@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct Tick {
+    int64_t timestamp;  // microseconds since epoch
+    double bid;
+    double ask;
+    int64_t volume;
+
+    double mid() const { return (bid + ask) / 2.0; }
+};
+
+// Read-only range of consecutive ticks, e.g. straight into the records of
+// a mapped .atk file. Does not own the ticks.
+struct TickView {
+    const Tick* first = nullptr;
+    const Tick* last = nullptr;
+
+    const Tick* begin() const { return first; }
+    const Tick* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    const Tick& operator[](size_t i) const { return first[i]; }
+    const Tick& back() const { return last[-1]; }
+};
+
+// Structure-of-arrays destination for batch reads. Each array must hold
+// at least as many elements as the batch capacity.
+struct TickColumns {
+    int64_t* timestamp;
+    double* bid;
+    double* ask;
+    int64_t* volume;
+};
@@ -0,0 +1,171 @@
+#include "TickCache.hpp"
+#include "ContinuousContract.hpp"
+#include "Dataset.hpp"
+#include "MarketDataReader.hpp"
+#include "TickFile.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kSampleBytes = 64 * 1024;
+constexpr size_t kBatchSize = 4096;  // Ticks per parse-and-write step
+
+std::string hex(uint64_t value) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(value));
+    return buf;
+}
+
+std::string pathPrefix(const std::string& absolute) {
+    return "artemis-" + hex(tickChecksum(absolute.data(), absolute.size())) + "-";
+}
+
+bool hasExtension(const std::string& path, const char* ext) {
+    return fs::path(path).extension() == ext;
+}
+
+}  // namespace
+
+TickCache::TickCache(const std::string& directory)
+    : directory_(directory) {}
+
+std::string TickCache::defaultDirectory() {
+    const char* dir = std::getenv("ARTEMIS_CACHE_DIR");
+    return dir && *dir ? dir : "/dev/shm";
+}
+
+bool TickCache::isAvailable() const {
+    std::error_code ec;
+    return fs::is_directory(directory_, ec);
+}
+
+bool TickCache::fingerprint(const std::string& path, uint64_t& hash) {
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) {
+        return false;
+    }
+    int64_t size = static_cast<int64_t>(fs::file_size(path, ec));
+    int64_t mtime = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    if (ec) {
+        return false;
+    }
+    
+    hash = tickChecksum(&size, sizeof(size));
+    hash = tickChecksum(&mtime, sizeof(mtime), hash);
+    
+    // Head and tail samples catch rewrites that keep size and mtime
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> sample(kSampleBytes);
+    in.read(sample.data(), sample.size());
+    hash = tickChecksum(sample.data(), static_cast<size_t>(in.gcount()), hash);
+    if (size > static_cast<int64_t>(kSampleBytes)) {
+        in.clear();
+        in.seekg(size - static_cast<int64_t>(kSampleBytes));
+        in.read(sample.data(), sample.size());
+        hash = tickChecksum(sample.data(), static_cast<size_t>(in.gcount()), hash);
+    }
+    return true;
+}
+
+std::string TickCache::entryName(const std::string& path) const {
+    uint64_t hash;
+    if (!fingerprint(path, hash)) {
+        return std::string();
+    }
+    std::error_code ec;
+    std::string absolute = fs::absolute(path, ec).lexically_normal().string();
+    if (ec) {
+        return std::string();
+    }
+    return pathPrefix(absolute) + hex(hash) + ".atk";
+}
+
+std::string TickCache::attach(const std::string& path, const std::string& instrument,
+                              double tickSize) const {
+    if (hasExtension(path, ".atk") || hasExtension(path, ".atc") ||
+        Dataset::isDatasetSpec(path) || ContinuousContract::isRollManifest(path)) {
+        return path;
+    }
+    std::string name = entryName(path);
+    if (name.empty()) {
+        return path;
+    }
+    
+    fs::path entry = fs::path(directory_) / name;
+    {
+        MarketDataReader cached(entry.string());
+        if (cached.isValid() && cached.format() == MarketDataReader::Format::Binary) {
+            return entry.string();
+        }
+    }
+    
+    MarketDataReader reader(path);
+    if (!reader.isValid()) {
+        return path;
+    }
+    if (reader.format() != MarketDataReader::Format::CSV) {
+        return path;  // Binary content under another extension
+    }
+    
+    // Write under a private name and rename into place, so concurrent
+    // processes only ever see complete entries. Ticks go straight from the
+    // parser to the writer a batch at a time.
+    fs::path temp = fs::path(directory_) / (name + "." + std::to_string(getpid()) + ".tmp");
+    uint64_t count = 0;
+    {
+        TickFileWriter writer(temp.string(), instrument, tickSize);
+        TickView batch;
+        while (writer.isValid() && !(batch = reader.nextView(kBatchSize)).empty()) {
+            writer.write(batch.begin(), batch.size());
+            count += batch.size();
+        }
+        if (reader.error()) {
+            writer.close();
+            std::error_code ec;
+            fs::remove(temp, ec);
+            throwIfReadFailed(reader, path);
+        }
+        if (!writer.isValid() || !writer.close()) {
+            std::error_code ec;
+            fs::remove(temp, ec);
+            throw std::runtime_error("Failed to write tick cache entry: " + temp.string());
+        }
+    }
+    std::error_code ec;
+    if (count == 0) {
+        fs::remove(temp, ec);
+        return path;
+    }
+    fs::rename(temp, entry, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        throw std::runtime_error("Failed to publish tick cache entry: " + entry.string());
+    }
+    
+    // Drop entries for older versions of the same file
+    std::string prefix = name.substr(0, name.rfind('-') + 1);
+    for (const auto& other : fs::directory_iterator(directory_, ec)) {
+        std::string otherName = other.path().filename().string();
+        if (otherName != name && otherName.compare(0, prefix.size(), prefix) == 0 &&
+            hasExtension(otherName, ".atk")) {
+            std::error_code removeEc;
+            fs::remove(other.path(), removeEc);
+        }
+    }
+    
+    return entry.string();
+}
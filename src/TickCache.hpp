@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Decoded-tick cache shared between artemis processes. The first process
+// to open a CSV parses it once and writes a .atk file (see TickFile.hpp)
+// into a RAM-backed directory, /dev/shm by default. Later processes map
+// that file read-only, so the kernel shares one copy of the ticks between
+// them and nothing is parsed again.
+//
+// Entries are named artemis-<path hash>-<file hash>.atk. The path hash
+// covers the absolute path; the file hash covers size, mtime and the first
+// and last 64 KiB. Editing the source gives a new name, and the stale
+// entry for the same path is removed when the new one is written.
+class TickCache {
+public:
+    explicit TickCache(const std::string& directory = defaultDirectory());
+    
+    // Cached .atk path for a CSV file, building the entry if missing with
+    // the given instrument and tick size in its header. Paths that are
+    // already binary, streams or datasets are returned unchanged. Throws
+    // std::runtime_error if the source cannot be read or the entry written.
+    std::string attach(const std::string& path, const std::string& instrument = "ES",
+                       double tickSize = 0.25) const;
+    
+    // Entry file name for path (without building it), empty if path cannot be stat'ed
+    std::string entryName(const std::string& path) const;
+    
+    // Hash of path's size, mtime and first and last 64 KiB. Returns false
+    // if path is not a regular file. Sampled rather than a hash of the whole
+    // file on purpose: hashing a multi-gigabyte source on every run would
+    // cost about as much as the parse the caches exist to skip. An edit in
+    // the middle of the file that keeps both size and mtime is not detected.
+    static bool fingerprint(const std::string& path, uint64_t& hash);
+    
+    // False if the cache directory does not exist
+    bool isAvailable() const;
+    
+    const std::string& directory() const { return directory_; }
+    
+    // $ARTEMIS_CACHE_DIR, else /dev/shm
+    static std::string defaultDirectory();
+
+private:
+    std::string directory_;
+};
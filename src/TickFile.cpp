@@ -0,0 +1,84 @@
+#include "TickFile.hpp"
+#include <cstring>
+#include <algorithm>
+
+uint64_t tickChecksum(const void* data, size_t bytes, uint64_t seed) {
+    const uint64_t prime = 0x100000001b3ULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+
+    size_t words = bytes / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        std::memcpy(&word, p + i * 8, 8);
+        hash = (hash ^ word) * prime;
+    }
+    for (size_t i = words * 8; i < bytes; ++i) {
+        hash = (hash ^ p[i]) * prime;
+    }
+    return hash;
+}
+
+bool isTickFile(const void* data, size_t size) {
+    if (!data || size < sizeof(TickFileHeader)) {
+        return false;
+    }
+
+    TickFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kTickFileMagic, sizeof(kTickFileMagic)) != 0 ||
+        header.version != kTickFileVersion ||
+        header.recordSize != sizeof(Tick)) {
+        return false;
+    }
+
+    // Truncated files are rejected rather than replayed short
+    return header.recordCount <= (size - sizeof(TickFileHeader)) / sizeof(Tick);
+}
+
+TickFileWriter::TickFileWriter(const std::string& filepath, const std::string& instrument,
+                               double tickSize)
+    : out_(filepath, std::ios::binary | std::ios::trunc) {
+    std::memset(&header_, 0, sizeof(header_));
+    std::memcpy(header_.magic, kTickFileMagic, sizeof(kTickFileMagic));
+    header_.version = kTickFileVersion;
+    header_.recordSize = sizeof(Tick);
+    std::memcpy(header_.instrument, instrument.data(),
+                std::min(instrument.size(), sizeof(header_.instrument) - 1));
+    header_.tickSize = tickSize;
+    header_.checksum = tickChecksum(nullptr, 0);
+
+    // Placeholder header, rewritten by close()
+    if (out_.is_open()) {
+        out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    }
+}
+
+TickFileWriter::~TickFileWriter() {
+    if (out_.is_open()) {
+        close();
+    }
+}
+
+void TickFileWriter::write(const Tick* ticks, size_t count) {
+    if (!out_.is_open() || count == 0) {
+        return;
+    }
+
+    size_t bytes = count * sizeof(Tick);
+    out_.write(reinterpret_cast<const char*>(ticks), bytes);
+    header_.checksum = tickChecksum(ticks, bytes, header_.checksum);
+    header_.recordCount += count;
+}
+
+bool TickFileWriter::close() {
+    if (!out_.is_open()) {
+        return false;
+    }
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    bool ok = out_.good();
+    out_.close();
+    return ok;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Tick.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+// Native binary tick file (.atk):
+//   TickFileHeader (64 bytes) followed by recordCount raw Tick records.
+// Records are fixed-width and 8-byte aligned in the mapping, so a reader
+// can hand them out without any parsing. Little-endian only.
+
+static_assert(sizeof(Tick) == 32, "Tick record layout changed; bump kTickFileVersion");
+
+constexpr char kTickFileMagic[8] = {'A', 'R', 'T', 'T', 'I', 'C', 'K', '\0'};
+constexpr uint32_t kTickFileVersion = 1;
+
+struct TickFileHeader {
+    char magic[8];          // kTickFileMagic
+    uint32_t version;       // kTickFileVersion
+    uint32_t recordSize;    // sizeof(Tick)
+    char instrument[16];    // NUL-padded symbol, e.g. "ES"
+    double tickSize;        // Minimum price increment
+    uint64_t recordCount;
+    uint64_t checksum;      // tickChecksum() over the record bytes
+    uint64_t reserved;
+};
+
+static_assert(sizeof(TickFileHeader) == 64, "TickFileHeader must stay 64 bytes");
+
+// FNV-1a over 64-bit words (tail bytes folded in individually).
+// Pass the previous result as seed to checksum data incrementally;
+// chunks other than the last must be a multiple of 8 bytes.
+uint64_t tickChecksum(const void* data, size_t bytes, uint64_t seed = 0xcbf29ce484222325ULL);
+
+// True if the mapping starts with a valid, complete tick file header
+bool isTickFile(const void* data, size_t size);
+
+class TickFileWriter {
+public:
+    TickFileWriter(const std::string& filepath, const std::string& instrument = "ES",
+                   double tickSize = 0.25);
+    ~TickFileWriter();
+
+    // Non-copyable
+    TickFileWriter(const TickFileWriter&) = delete;
+    TickFileWriter& operator=(const TickFileWriter&) = delete;
+
+    // Append records
+    void write(const Tick& tick) { write(&tick, 1); }
+    void write(const Tick* ticks, size_t count);
+
+    // Finalize header (count, checksum). Returns false on I/O error.
+    bool close();
+
+    bool isValid() const { return out_.is_open() && out_.good(); }
+    uint64_t recordCount() const { return header_.recordCount; }
+
+private:
+    std::ofstream out_;
+    TickFileHeader header_;
+};
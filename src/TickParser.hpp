@@ -0,0 +1,234 @@
+#pragma once
+
+#include "Tick.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>  // For SIMD delimiter search
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Allocation-free parser for "timestamp,bid,ask,volume" lines.
+// Works directly on the mapped bytes: no std::string, no istringstream,
+// no locale. Delimiters are located 64 bytes at a time with SSE2/AVX2
+// compares, and prices are decoded as scaled integers so quarter-tick
+// ES prices come out exact.
+class TickParser {
+public:
+    // Parse the line starting at p. Returns a pointer just past the line's
+    // '\n' (or end). ok is false for empty or malformed lines.
+    static const char* parseNext(const char* p, const char* end, Tick& tick, bool& ok) {
+        if (end - p >= 64) {
+            uint64_t newlines = matchMask64(p, '\n');
+            if (newlines) {
+                const char* eol = p + countTrailingZeros(newlines);
+                uint64_t commas = matchMask64(p, ',') & ((newlines & (0 - newlines)) - 1);
+                ok = parseFields(p, eol, commas, tick);
+                return eol + 1;
+            }
+        }
+
+        // Long line or near the end of the mapping: scalar path
+        const char* eol = findNewline(p, end);
+        ok = parseLine(p, eol, tick);
+        return eol < end ? eol + 1 : end;
+    }
+
+    // Parse a single line [line, lineEnd), excluding the '\n'.
+    static bool parseLine(const char* line, const char* lineEnd, Tick& tick) {
+        const char* comma[3];
+        const char* p = line;
+        for (int i = 0; i < 3; ++i) {
+            p = static_cast<const char*>(memchr(p, ',', lineEnd - p));
+            if (!p) return false;
+            comma[i] = p++;
+        }
+        const char* volEnd = static_cast<const char*>(memchr(p, ',', lineEnd - p));
+        return parseTick(line, comma, volEnd ? volEnd : lineEnd, lineEnd, tick);
+    }
+
+    // Find the next '\n' in [p, end), or end if there is none
+    static const char* findNewline(const char* p, const char* end) {
+#if defined(__AVX2__)
+        const __m256i nl = _mm256_set1_epi8('\n');
+        while (end - p >= 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, nl)));
+            if (mask) return p + countTrailingZeros(mask);
+            p += 32;
+        }
+#endif
+        const char* nlPos = static_cast<const char*>(memchr(p, '\n', end - p));
+        return nlPos ? nlPos : end;
+    }
+
+    // Count '\n' bytes in [p, end). The AVX2 path accumulates compare
+    // results in byte lanes and folds them with SAD every 255 vectors, so
+    // it runs at memory bandwidth.
+    static size_t countNewlines(const char* p, const char* end) {
+        size_t count = 0;
+#if defined(__AVX2__)
+        const __m256i nl = _mm256_set1_epi8('\n');
+        const __m256i zero = _mm256_setzero_si256();
+        while (end - p >= 32) {
+            size_t blocks = std::min<size_t>(255, (end - p) / 32);
+            __m256i acc = zero;
+            for (size_t i = 0; i < blocks; ++i, p += 32) {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(chunk, nl));  // cmpeq is 0 / -1
+            }
+            __m256i sums = _mm256_sad_epu8(acc, zero);
+            count += static_cast<size_t>(_mm256_extract_epi64(sums, 0)) +
+                     static_cast<size_t>(_mm256_extract_epi64(sums, 1)) +
+                     static_cast<size_t>(_mm256_extract_epi64(sums, 2)) +
+                     static_cast<size_t>(_mm256_extract_epi64(sums, 3));
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i nl = _mm_set1_epi8('\n');
+        while (end - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            count += popcount(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl))));
+            p += 16;
+        }
+#endif
+        for (; p < end; ++p) {
+            count += (*p == '\n');
+        }
+        return count;
+    }
+
+    // Signed decimal integer, no whitespace
+    static bool parseInt(const char* b, const char* e, int64_t& out) {
+        bool neg = false;
+        if (b < e && (*b == '-' || *b == '+')) {
+            neg = (*b == '-');
+            ++b;
+        }
+        if (b == e || e - b > 18) return false;
+
+        int64_t value = 0;
+        for (; b < e; ++b) {
+            unsigned d = static_cast<unsigned>(*b - '0');
+            if (d > 9) return false;
+            value = value * 10 + d;
+        }
+        out = neg ? -value : value;
+        return true;
+    }
+
+    // Fixed-point decimal price. Digits are accumulated into an integer
+    // mantissa and divided once by a power of ten, which is exact for any
+    // price representable as a double (e.g. 4500.25).
+    static bool parsePrice(const char* b, const char* e, double& out) {
+        static const double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+        int64_t mantissa;
+        int decimals;
+        if (!parseDecimal(b, e, mantissa, decimals)) return false;
+        out = static_cast<double>(mantissa) / kPow10[decimals];
+        return true;
+    }
+
+    // Signed decimal as mantissa / 10^decimals, at most 18 digits
+    static bool parseDecimal(const char* b, const char* e, int64_t& mantissa, int& decimals) {
+        bool neg = false;
+        if (b < e && (*b == '-' || *b == '+')) {
+            neg = (*b == '-');
+            ++b;
+        }
+
+        int64_t value = 0;
+        int digits = 0;
+        int frac = -1;
+        for (; b < e; ++b) {
+            unsigned d = static_cast<unsigned>(*b - '0');
+            if (d <= 9) {
+                value = value * 10 + d;
+                ++digits;
+                if (frac >= 0) ++frac;
+            } else if (*b == '.' && frac < 0) {
+                frac = 0;
+            } else {
+                return false;
+            }
+        }
+        if (digits == 0 || digits > 18) return false;
+
+        mantissa = neg ? -value : value;
+        decimals = frac > 0 ? frac : 0;
+        return true;
+    }
+
+private:
+    static unsigned countTrailingZeros(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long idx;
+        _BitScanForward64(&idx, x);
+        return static_cast<unsigned>(idx);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+    }
+
+    static unsigned popcount(uint32_t x) {
+#ifdef _MSC_VER
+        return __popcnt(x);
+#else
+        return static_cast<unsigned>(__builtin_popcount(x));
+#endif
+    }
+
+    // Bitmask of bytes equal to c in the 64 bytes starting at p
+    static uint64_t matchMask64(const char* p, char c) {
+#if defined(__AVX2__)
+        const __m256i needle = _mm256_set1_epi8(c);
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        uint64_t mlo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+        uint64_t mhi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+        return mlo | (mhi << 32);
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i needle = _mm_set1_epi8(c);
+        uint64_t mask = 0;
+        for (int i = 0; i < 4; ++i) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+            uint64_t m = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+            mask |= m << (16 * i);
+        }
+        return mask;
+#else
+        uint64_t mask = 0;
+        for (int i = 0; i < 64; ++i) {
+            mask |= static_cast<uint64_t>(p[i] == c) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Fields of [line, eol) given the comma bitmask relative to line
+    static bool parseFields(const char* line, const char* eol, uint64_t commas, Tick& tick) {
+        const char* comma[3];
+        for (int i = 0; i < 3; ++i) {
+            if (!commas) return false;
+            comma[i] = line + countTrailingZeros(commas);
+            commas &= commas - 1;
+        }
+        const char* volEnd = commas ? line + countTrailingZeros(commas) : eol;
+        return parseTick(line, comma, volEnd, eol, tick);
+    }
+
+    static bool parseTick(const char* line, const char* const comma[3], const char* volEnd,
+                          const char* eol, Tick& tick) {
+        if (volEnd == eol && volEnd > line && volEnd[-1] == '\r') {
+            --volEnd;  // Windows line ending
+        }
+        return parseInt(line, comma[0], tick.timestamp) &&
+               parsePrice(comma[0] + 1, comma[1], tick.bid) &&
+               parsePrice(comma[1] + 1, comma[2], tick.ask) &&
+               parseInt(comma[2] + 1, volEnd, tick.volume);
+    }
+};
@@ -0,0 +1,61 @@
+#include "TickSource.hpp"
+#include "MarketDataReader.hpp"
+#include "StreamReader.hpp"
+#include "TickFile.hpp"
+#include "TickStore.hpp"
+#ifndef _WIN32
+#include "UringReader.hpp"
+#endif
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace {
+
+// .atk/.atc are recognised by their magic, as in MarketDataReader
+bool hasBinaryMagic(const std::string& path) {
+    char magic[8] = {};
+    std::ifstream in(path, std::ios::binary);
+    in.read(magic, sizeof(magic));
+    return std::memcmp(magic, kTickFileMagic, sizeof(magic)) == 0 ||
+           std::memcmp(magic, kColumnStoreMagic, sizeof(magic)) == 0;
+}
+
+}  // namespace
+
+void throwIfReadFailed(const TickSource& source, const std::string& path) {
+    if (int err = source.error()) {
+        throw std::runtime_error("Read error in " + path + ": " + std::strerror(err));
+    }
+}
+
+bool isStreamPath(const std::string& path) {
+    if (path == "-") {
+        return true;
+    }
+    
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;  // Let the mapped reader report the missing file
+    }
+#ifdef _WIN32
+    return (st.st_mode & _S_IFMT) != _S_IFREG;
+#else
+    return !S_ISREG(st.st_mode);
+#endif
+}
+
+std::unique_ptr<TickSource> openTickSource(const std::string& path, IoBackend backend) {
+    if (isStreamPath(path)) {
+        return std::make_unique<StreamReader>(path);
+    }
+#ifndef _WIN32
+    if (backend == IoBackend::Uring && !hasBinaryMagic(path)) {
+        return std::make_unique<UringReader>(path);
+    }
+#else
+    (void)backend;
+#endif
+    return std::make_unique<MarketDataReader>(path);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Tick.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Pull interface shared by the tick backends (mapped files, pipes, ...).
+// Consumers should prefer nextBatch: the virtual call is paid per batch.
+class TickSource {
+public:
+    virtual ~TickSource() = default;
+
+    // Read next tick, returns false if EOF
+    virtual bool next(Tick& tick) = 0;
+
+    // Read up to maxTicks ticks into out, returns number read (0 at EOF)
+    virtual size_t nextBatch(Tick* out, size_t maxTicks) = 0;
+
+    // Columnar variant: fills separate timestamp/bid/ask/volume arrays.
+    // Built on nextView, so the virtual call is paid once per batch.
+    size_t nextBatch(const TickColumns& out, size_t maxTicks) {
+        size_t n = 0;
+        while (n < maxTicks) {
+            TickView view = nextView(maxTicks - n);
+            if (view.empty()) {
+                break;
+            }
+            for (const Tick& tick : view) {
+                out.timestamp[n] = tick.timestamp;
+                out.bid[n] = tick.bid;
+                out.ask[n] = tick.ask;
+                out.volume[n] = tick.volume;
+                n++;
+            }
+        }
+        return n;
+    }
+
+    // Up to maxTicks ticks without copying where the backend already holds
+    // them in memory (mapped .atk records, decoded .atc blocks); others fill
+    // an internal buffer. Empty at EOF. Valid until the next read call.
+    virtual TickView nextView(size_t maxTicks) {
+        if (viewBuffer_.size() < maxTicks) {
+            viewBuffer_.resize(maxTicks);
+        }
+        size_t n = nextBatch(viewBuffer_.data(), maxTicks);
+        return TickView{viewBuffer_.data(), viewBuffer_.data() + n};
+    }
+    
+    // Exact or upper-bound tick count if known up front, 0 otherwise
+    virtual size_t tickCount() const { return 0; }
+
+    virtual bool isValid() const = 0;
+    
+    // errno of a read failure that ended the input early, 0 otherwise.
+    // next/nextBatch/nextView see such a failure as EOF, so consumers check
+    // this once the input ends (see throwIfReadFailed).
+    virtual int error() const { return 0; }
+
+private:
+    std::vector<Tick> viewBuffer_;  // Backing store for the copying nextView
+};
+
+// How regular files are read
+enum class IoBackend {
+    Mmap,   // MarketDataReader: mapped CSV, .atk or .atc
+    Uring   // UringReader for CSV (Linux io_uring; mapped reader elsewhere
+            // and for binary formats)
+};
+
+// Throws std::runtime_error naming path if source stopped on a read error
+void throwIfReadFailed(const TickSource& source, const std::string& path);
+
+// True for "-" (stdin) and paths that are pipes, FIFOs or devices
+bool isStreamPath(const std::string& path);
+
+// Open path with the matching backend: StreamReader for stream paths,
+// otherwise the requested backend for regular files
+std::unique_ptr<TickSource> openTickSource(const std::string& path,
+                                           IoBackend backend = IoBackend::Mmap);
@@ -0,0 +1,249 @@
+#include "TickStore.hpp"
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+uint64_t zigzag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+// Returns nullptr on overrun
+const uint8_t* getVarint(const uint8_t* p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+PriceTicks toTicks(double price, const PriceScale& scale) {
+    if (!scale.onGrid(price)) {
+        throw std::invalid_argument("Price " + std::to_string(price) +
+                                    " is not a multiple of the tick size");
+    }
+    return scale.toTicks(price);
+}
+
+}  // namespace
+
+bool isColumnStore(const void* data, size_t size) {
+    if (!data || size < sizeof(ColumnStoreHeader)) {
+        return false;
+    }
+
+    ColumnStoreHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kColumnStoreMagic, sizeof(kColumnStoreMagic)) != 0 ||
+        header.version != kColumnStoreVersion ||
+        !(header.tickSize > 0.0) ||
+        header.blockSize == 0 || header.blockSize > kMaxColumnBlockSize ||
+        header.indexOffset < sizeof(ColumnStoreHeader) || header.indexOffset > size ||
+        header.blockCount > (size - header.indexOffset) / sizeof(ColumnBlockIndex)) {
+        return false;
+    }
+
+    // Every block must lie between the header and the index and hold at
+    // most blockSize ticks, so a corrupt index cannot drive the reader's
+    // allocations or reads
+    const char* index = static_cast<const char*>(data) + header.indexOffset;
+    for (uint64_t i = 0; i < header.blockCount; ++i) {
+        ColumnBlockIndex entry;
+        std::memcpy(&entry, index + i * sizeof(entry), sizeof(entry));
+        if (entry.count == 0 || entry.count > header.blockSize ||
+            entry.offset < sizeof(ColumnStoreHeader) || entry.offset > header.indexOffset ||
+            entry.bytes > header.indexOffset - entry.offset) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t decodeColumnBlock(const void* block, size_t bytes, double tickSize, Tick* out,
+                         size_t capacity) {
+    if (bytes < sizeof(ColumnBlockHeader)) {
+        return 0;
+    }
+
+    ColumnBlockHeader header;
+    std::memcpy(&header, block, sizeof(header));
+    const uint8_t* columns = static_cast<const uint8_t*>(block) + sizeof(header);
+    const uint8_t* end = static_cast<const uint8_t*>(block) + bytes;
+    size_t columnBytes = bytes - sizeof(header);
+    if (header.count == 0 || header.count > capacity || header.bidOffset > columnBytes ||
+        header.askOffset > columnBytes || header.volumeOffset > columnBytes) {
+        return 0;
+    }
+
+    const uint32_t n = header.count;
+    uint64_t v;
+
+    // Decoded prices match the CSV parser bit for bit (see PriceScale::toPrice)
+    const PriceScale scale(tickSize);
+
+    // Timestamps: delta-of-delta
+    const uint8_t* p = columns;
+    int64_t ts = header.baseTimestamp;
+    int64_t delta = 0;
+    out[0].timestamp = ts;
+    for (uint32_t i = 1; i < n; ++i) {
+        if (!(p = getVarint(p, end, v))) return 0;
+        delta += unzigzag(v);
+        ts += delta;
+        out[i].timestamp = ts;
+    }
+
+    // Bid: offset from base, in ticks. Ask: spread over bid, in ticks.
+    // Both columns are walked together so the bid ticks stay in a local.
+    p = columns + header.bidOffset;
+    const uint8_t* q = columns + header.askOffset;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!(p = getVarint(p, end, v))) return 0;
+        PriceTicks bid = header.basePrice + unzigzag(v);
+        if (!(q = getVarint(q, end, v))) return 0;
+        out[i].bid = scale.toPrice(bid);
+        out[i].ask = scale.toPrice(bid + unzigzag(v));
+    }
+
+    p = columns + header.volumeOffset;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!(p = getVarint(p, end, v))) return 0;
+        out[i].volume = unzigzag(v);
+    }
+
+    return n;
+}
+
+ColumnarTickWriter::ColumnarTickWriter(const std::string& filepath, const std::string& instrument,
+                                       double tickSize, uint32_t blockSize)
+    : out_(filepath, std::ios::binary | std::ios::trunc),
+      scale_(tickSize) {
+    std::memset(&header_, 0, sizeof(header_));
+    std::memcpy(header_.magic, kColumnStoreMagic, sizeof(kColumnStoreMagic));
+    header_.version = kColumnStoreVersion;
+    header_.blockSize = std::clamp<uint32_t>(blockSize, 1, kMaxColumnBlockSize);
+    std::memcpy(header_.instrument, instrument.data(),
+                std::min(instrument.size(), sizeof(header_.instrument) - 1));
+    header_.tickSize = tickSize;
+    pending_.reserve(header_.blockSize);
+    bidTicks_.reserve(header_.blockSize);
+    askTicks_.reserve(header_.blockSize);
+
+    // Placeholder header, rewritten by close()
+    if (out_.is_open()) {
+        out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    }
+}
+
+ColumnarTickWriter::~ColumnarTickWriter() {
+    if (out_.is_open()) {
+        close();
+    }
+}
+
+void ColumnarTickWriter::write(const Tick* ticks, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        // Validate before buffering so close() never throws
+        PriceTicks bid = toTicks(ticks[i].bid, scale_);
+        PriceTicks ask = toTicks(ticks[i].ask, scale_);
+        pending_.push_back(ticks[i]);
+        bidTicks_.push_back(bid);
+        askTicks_.push_back(ask);
+        if (pending_.size() == header_.blockSize) {
+            flushBlock();
+        }
+    }
+}
+
+void ColumnarTickWriter::flushBlock() {
+    if (pending_.empty() || !out_.is_open()) {
+        return;
+    }
+
+    const size_t n = pending_.size();
+
+    ColumnBlockHeader block;
+    block.baseTimestamp = pending_[0].timestamp;
+    block.basePrice = bidTicks_[0];
+    block.count = static_cast<uint32_t>(n);
+
+    encoded_.clear();
+    int64_t prevDelta = 0;
+    int64_t minTs = pending_[0].timestamp;
+    int64_t maxTs = pending_[0].timestamp;
+    for (size_t i = 1; i < n; ++i) {
+        int64_t delta = pending_[i].timestamp - pending_[i - 1].timestamp;
+        putVarint(encoded_, zigzag(delta - prevDelta));
+        prevDelta = delta;
+        minTs = std::min(minTs, pending_[i].timestamp);
+        maxTs = std::max(maxTs, pending_[i].timestamp);
+    }
+
+    block.bidOffset = static_cast<uint32_t>(encoded_.size());
+    for (size_t i = 0; i < n; ++i) {
+        putVarint(encoded_, zigzag(bidTicks_[i] - block.basePrice));
+    }
+
+    block.askOffset = static_cast<uint32_t>(encoded_.size());
+    for (size_t i = 0; i < n; ++i) {
+        putVarint(encoded_, zigzag(askTicks_[i] - bidTicks_[i]));
+    }
+
+    block.volumeOffset = static_cast<uint32_t>(encoded_.size());
+    for (size_t i = 0; i < n; ++i) {
+        putVarint(encoded_, zigzag(pending_[i].volume));
+    }
+
+    ColumnBlockIndex entry;
+    entry.minTimestamp = minTs;
+    entry.maxTimestamp = maxTs;
+    entry.offset = static_cast<uint64_t>(out_.tellp());
+    entry.count = block.count;
+    entry.bytes = static_cast<uint32_t>(sizeof(block) + encoded_.size());
+    index_.push_back(entry);
+
+    out_.write(reinterpret_cast<const char*>(&block), sizeof(block));
+    out_.write(reinterpret_cast<const char*>(encoded_.data()), encoded_.size());
+
+    header_.tickCount += n;
+    pending_.clear();
+    bidTicks_.clear();
+    askTicks_.clear();
+}
+
+bool ColumnarTickWriter::close() {
+    if (!out_.is_open()) {
+        return false;
+    }
+
+    flushBlock();
+
+    header_.blockCount = index_.size();
+    header_.indexOffset = static_cast<uint64_t>(out_.tellp());
+    out_.write(reinterpret_cast<const char*>(index_.data()),
+               index_.size() * sizeof(ColumnBlockIndex));
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    bool ok = out_.good();
+    out_.close();
+    return ok;
+}
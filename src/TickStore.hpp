@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Tick.hpp"
+#include "Price.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Columnar, compressed tick store (.atc):
+//
+//   ColumnStoreHeader (64 bytes)
+//   block 0 .. block N-1
+//   ColumnBlockIndex[N]              (at header.indexOffset)
+//
+// Each block holds up to blockSize ticks as a ColumnBlockHeader followed by
+// four varint columns:
+//   timestamps  zigzag delta-of-delta from baseTimestamp
+//   bid         zigzag offset in ticks from basePrice
+//   ask         zigzag spread in ticks over bid
+//   volume      zigzag varint
+// The block index carries each block's min/max timestamp so readers can
+// skip blocks without decoding them. Little-endian only.
+
+constexpr char kColumnStoreMagic[8] = {'A', 'R', 'T', 'C', 'O', 'L', 'S', '\0'};
+constexpr uint32_t kColumnStoreVersion = 1;
+constexpr uint32_t kDefaultColumnBlockSize = 4096;
+constexpr uint32_t kMaxColumnBlockSize = 1u << 20;  // Readers reject larger blocks
+
+struct ColumnStoreHeader {
+    char magic[8];          // kColumnStoreMagic
+    uint32_t version;       // kColumnStoreVersion
+    uint32_t blockSize;     // Max ticks per block
+    char instrument[16];    // NUL-padded symbol, e.g. "ES"
+    double tickSize;        // Price quantum for bid/ask columns
+    uint64_t tickCount;
+    uint64_t blockCount;
+    uint64_t indexOffset;   // File offset of ColumnBlockIndex[blockCount]
+};
+
+struct ColumnBlockIndex {
+    int64_t minTimestamp;
+    int64_t maxTimestamp;
+    uint64_t offset;        // File offset of the ColumnBlockHeader
+    uint32_t count;         // Ticks in block
+    uint32_t bytes;         // Encoded size including ColumnBlockHeader
+};
+
+struct ColumnBlockHeader {
+    int64_t baseTimestamp;  // First timestamp in the block
+    int64_t basePrice;      // First bid, in ticks
+    uint32_t count;
+    uint32_t bidOffset;     // Column offsets relative to the end of this header
+    uint32_t askOffset;
+    uint32_t volumeOffset;
+};
+
+static_assert(sizeof(ColumnStoreHeader) == 64, "ColumnStoreHeader must stay 64 bytes");
+static_assert(sizeof(ColumnBlockIndex) == 32, "ColumnBlockIndex must stay 32 bytes");
+static_assert(sizeof(ColumnBlockHeader) == 32, "ColumnBlockHeader must stay 32 bytes");
+
+// True if the mapping holds a complete column store whose index entries
+// all point at in-bounds blocks of at most blockSize ticks
+bool isColumnStore(const void* data, size_t size);
+
+// Decode one block into out. Returns the number of ticks decoded, or 0 if
+// the block is corrupt or holds more than capacity ticks.
+size_t decodeColumnBlock(const void* block, size_t bytes, double tickSize, Tick* out,
+                         size_t capacity);
+
+class ColumnarTickWriter {
+public:
+    ColumnarTickWriter(const std::string& filepath, const std::string& instrument = "ES",
+                       double tickSize = 0.25, uint32_t blockSize = kDefaultColumnBlockSize);
+    ~ColumnarTickWriter();
+
+    // Non-copyable
+    ColumnarTickWriter(const ColumnarTickWriter&) = delete;
+    ColumnarTickWriter& operator=(const ColumnarTickWriter&) = delete;
+
+    // Append ticks (must be in timestamp order). Throws std::invalid_argument
+    // if a bid/ask is not a multiple of the tick size.
+    void write(const Tick& tick) { write(&tick, 1); }
+    void write(const Tick* ticks, size_t count);
+
+    // Flush the last block, write the index and finalize the header
+    bool close();
+
+    bool isValid() const { return out_.is_open() && out_.good(); }
+    uint64_t tickCount() const { return header_.tickCount + pending_.size(); }
+
+private:
+    std::ofstream out_;
+    ColumnStoreHeader header_;
+    PriceScale scale_;
+    std::vector<Tick> pending_;
+    std::vector<PriceTicks> bidTicks_;   // pending_ prices in ticks
+    std::vector<PriceTicks> askTicks_;
+    std::vector<ColumnBlockIndex> index_;
+    std::vector<uint8_t> encoded_;
+
+    void flushBlock();
+};
@@ -0,0 +1,204 @@
+#include "TickValidator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct IssueCounts {
+    uint64_t crossed = 0;
+    uint64_t locked = 0;
+    uint64_t badPrice = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t gaps = 0;
+};
+
+bool validPrice(double price) {
+    return price > 0.0 && price < std::numeric_limits<double>::infinity();  // false for NaN
+}
+
+bool badPrice(const Tick& tick) {
+    return !validPrice(tick.bid) || !validPrice(tick.ask) || tick.volume < 0;
+}
+
+#if defined(__AVX2__)
+// Set bits in a 4-lane movemask
+unsigned popcount4(int mask) {
+    static const unsigned char kBits[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    return kBits[mask & 0xF];
+}
+#endif
+
+// Count every issue in the batch. prev is the timestamp before ticks[0].
+IssueCounts countIssues(const Tick* ticks, size_t count, int64_t prev, int64_t maxGap) {
+    IssueCounts c;
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    const __m256i gapLimit = _mm256_set1_epi64x(maxGap);
+    __m256i prevTs = _mm256_set1_epi64x(prev);
+    for (; i + 4 <= count; i += 4) {
+        // Each Tick is one 256-bit row; transpose four rows into columns
+        const __m256i* p = reinterpret_cast<const __m256i*>(ticks + i);
+        __m256i r0 = _mm256_loadu_si256(p);
+        __m256i r1 = _mm256_loadu_si256(p + 1);
+        __m256i r2 = _mm256_loadu_si256(p + 2);
+        __m256i r3 = _mm256_loadu_si256(p + 3);
+        __m256i t0 = _mm256_unpacklo_epi64(r0, r1);  // ts0 ts1 ask0 ask1
+        __m256i t1 = _mm256_unpackhi_epi64(r0, r1);  // bid0 bid1 vol0 vol1
+        __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+        __m256i ts = _mm256_permute2x128_si256(t0, t2, 0x20);
+        __m256d ask = _mm256_castsi256_pd(_mm256_permute2x128_si256(t0, t2, 0x31));
+        __m256d bid = _mm256_castsi256_pd(_mm256_permute2x128_si256(t1, t3, 0x20));
+        __m256i vol = _mm256_permute2x128_si256(t1, t3, 0x31);
+        
+        // Previous timestamps: last of the prior step, then ts0..ts2
+        __m256i before = _mm256_blend_epi32(_mm256_permute4x64_epi64(ts, _MM_SHUFFLE(2, 1, 0, 0)),
+                                            _mm256_permute4x64_epi64(prevTs, _MM_SHUFFLE(3, 3, 3, 3)), 0x03);
+        prevTs = ts;
+        
+        __m256d good = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(bid, zero, _CMP_GT_OQ),
+                                                   _mm256_cmp_pd(bid, inf, _CMP_LT_OQ)),
+                                     _mm256_and_pd(_mm256_cmp_pd(ask, zero, _CMP_GT_OQ),
+                                                   _mm256_cmp_pd(ask, inf, _CMP_LT_OQ)));
+        int negVol = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_setzero_si256(), vol)));
+        
+        c.crossed += popcount4(_mm256_movemask_pd(_mm256_cmp_pd(bid, ask, _CMP_GT_OQ)));
+        c.locked += popcount4(_mm256_movemask_pd(_mm256_cmp_pd(bid, ask, _CMP_EQ_OQ)));
+        c.badPrice += popcount4((~_mm256_movemask_pd(good) & 0xF) | negVol);
+        c.outOfOrder += popcount4(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(before, ts))));
+        c.gaps += popcount4(_mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_sub_epi64(ts, before), gapLimit))));
+    }
+    if (i > 0) {
+        prev = ticks[i - 1].timestamp;
+    }
+#endif
+    for (; i < count; ++i) {
+        const Tick& t = ticks[i];
+        c.crossed += t.bid > t.ask;
+        c.locked += t.bid == t.ask;
+        c.badPrice += badPrice(t);
+        c.outOfOrder += t.timestamp < prev;
+        c.gaps += t.timestamp - prev > maxGap;
+        prev = t.timestamp;
+    }
+    return c;
+}
+
+}  // namespace
+
+TickValidator::TickValidator(const ValidationOptions& options)
+    : options_(options), last_{}, hasLast_(false) {}
+
+void TickValidator::reset() {
+    reset(ValidationStats());
+}
+
+void TickValidator::reset(const ValidationStats& stats) {
+    stats_ = stats;
+    last_ = Tick{};
+    hasLast_ = false;
+}
+
+bool TickValidator::screen(const Tick* ticks, size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    
+    int64_t maxGap = options_.maxGap > 0 ? options_.maxGap : std::numeric_limits<int64_t>::max();
+    IssueCounts c = countIssues(ticks, count, hasLast_ ? last_.timestamp : ticks[0].timestamp, maxGap);
+    
+    // Locked quotes have no repair, so only Drop makes them actionable
+    if ((c.crossed && options_.crossed != TickAction::Flag) ||
+        (c.locked && options_.locked == TickAction::Drop) ||
+        (c.badPrice && options_.badPrice != TickAction::Flag) ||
+        (c.outOfOrder && options_.outOfOrder != TickAction::Flag)) {
+        return false;
+    }
+    
+    stats_.ticks += count;
+    stats_.crossed += c.crossed;
+    stats_.locked += c.locked;
+    stats_.badPrice += c.badPrice;
+    stats_.outOfOrder += c.outOfOrder;
+    stats_.gaps += c.gaps;
+    last_ = ticks[count - 1];
+    hasLast_ = true;
+    return true;
+}
+
+size_t TickValidator::process(Tick* ticks, size_t count) {
+    int64_t maxGap = options_.maxGap > 0 ? options_.maxGap : std::numeric_limits<int64_t>::max();
+    size_t out = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Tick t = ticks[i];
+        bool bad = badPrice(t);
+        bool crossed = t.bid > t.ask;
+        bool locked = t.bid == t.ask;
+        bool late = hasLast_ && t.timestamp < last_.timestamp;
+        bool gap = hasLast_ && t.timestamp - last_.timestamp > maxGap;
+        
+        stats_.ticks++;
+        stats_.badPrice += bad;
+        stats_.crossed += crossed;
+        stats_.locked += locked;
+        stats_.outOfOrder += late;
+        stats_.gaps += gap;
+        
+        bool drop = (bad && options_.badPrice == TickAction::Drop) ||
+                    (crossed && options_.crossed == TickAction::Drop) ||
+                    (locked && options_.locked == TickAction::Drop) ||
+                    (late && options_.outOfOrder == TickAction::Drop);
+        bool repaired = false;
+        if (!drop && bad && options_.badPrice == TickAction::Repair) {
+            if (hasLast_) {
+                t.bid = last_.bid;
+                t.ask = last_.ask;
+                t.volume = std::max<int64_t>(t.volume, 0);
+                repaired = true;
+            } else {
+                drop = true;  // No earlier quote to carry forward
+            }
+        } else if (!drop && crossed && options_.crossed == TickAction::Repair) {
+            std::swap(t.bid, t.ask);
+            repaired = true;
+        }
+        if (!drop && late && options_.outOfOrder == TickAction::Repair) {
+            t.timestamp = last_.timestamp;
+            repaired = true;
+        }
+        
+        if (drop) {
+            stats_.dropped++;
+            continue;
+        }
+        stats_.repaired += repaired;
+        ticks[out++] = t;
+        last_ = t;
+        hasLast_ = true;
+    }
+    return out;
+}
+
+size_t TickValidator::apply(Tick* ticks, size_t count) {
+    if (screen(ticks, count)) {
+        return count;
+    }
+    return process(ticks, count);
+}
+
+TickView TickValidator::apply(TickView ticks) {
+    if (screen(ticks.begin(), ticks.size())) {
+        return ticks;
+    }
+    buffer_.assign(ticks.begin(), ticks.end());
+    size_t n = process(buffer_.data(), buffer_.size());
+    return TickView{buffer_.data(), buffer_.data() + n};
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Tick.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// What to do with a tick that fails a check
+enum class TickAction {
+    Flag,    // Keep it unchanged, only count it
+    Drop,    // Remove it from the stream
+    Repair   // Fix it up: crossed quotes are swapped, bad prices carry the
+             // previous quote forward, late timestamps are clamped to the
+             // previous one. Locked quotes have no repair (same as Flag).
+};
+
+struct ValidationOptions {
+    TickAction crossed = TickAction::Drop;     // bid > ask
+    TickAction locked = TickAction::Flag;      // bid == ask
+    TickAction badPrice = TickAction::Drop;    // Zero, negative or non-finite price, negative volume
+    TickAction outOfOrder = TickAction::Drop;  // Timestamp before the previous tick's
+    int64_t maxGap = 0;                        // >0: count gaps longer than this (microseconds)
+};
+
+// Per-run counters. Issue counts include flagged ticks; a tick with
+// several problems is counted under each of them.
+struct ValidationStats {
+    uint64_t ticks = 0;       // Ticks checked
+    uint64_t crossed = 0;
+    uint64_t locked = 0;
+    uint64_t badPrice = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t gaps = 0;
+    uint64_t dropped = 0;
+    uint64_t repaired = 0;
+};
+
+// Data quality stage between a reader and its consumer. Batches are first
+// screened with AVX2 compares (four ticks per step, scalar elsewhere) that
+// only count problems; the per-tick path runs only for batches holding a
+// tick to drop or repair, so clean data costs a few cycles per tick.
+class TickValidator {
+public:
+    explicit TickValidator(const ValidationOptions& options = ValidationOptions());
+    
+    // Validate ticks in place, compacting out dropped ones. Returns the new count.
+    size_t apply(Tick* ticks, size_t count);
+    
+    // Clean views are returned as they are (no copy); otherwise the result
+    // is built in an internal buffer valid until the next call
+    TickView apply(TickView ticks);
+    
+    const ValidationStats& stats() const { return stats_; }
+    const ValidationOptions& options() const { return options_; }
+    
+    // Clear counters and forget the previous tick
+    void reset();
+    
+    // As reset(), but continue from stats counted elsewhere (e.g. stored
+    // with a cached series)
+    void reset(const ValidationStats& stats);
+
+private:
+    ValidationOptions options_;
+    ValidationStats stats_;
+    Tick last_;       // Last tick passed through
+    bool hasLast_;
+    std::vector<Tick> buffer_;
+    
+    // Screen [ticks, ticks + count) into stats_ if no tick needs a drop or
+    // repair; returns false (stats_ untouched) otherwise
+    bool screen(const Tick* ticks, size_t count);
+    size_t process(Tick* ticks, size_t count);
+};
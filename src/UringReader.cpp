@@ -0,0 +1,330 @@
+#include "UringReader.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ARTEMIS_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+constexpr size_t kAlignment = 4096;  // O_DIRECT buffer/offset/length alignment
+
+}  // namespace
+
+#ifdef ARTEMIS_HAVE_IO_URING
+
+// Minimal io_uring driver over the raw syscalls (no liburing dependency):
+// one SQ entry per chunk read, completions matched back by slot index.
+struct UringReader::Ring {
+    int fd = -1;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+    
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    
+    bool init(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return false;
+        }
+        
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMap) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+        
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) {
+            return false;
+        }
+        cqRing = singleMap ? sqRing
+                           : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            return false;
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+    
+    ~Ring() {
+        if (sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        if (fd >= 0) close(fd);
+    }
+    
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        while (true) {
+            long r = syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0);
+            if (r >= 0 || (errno != EINTR && errno != EAGAIN)) {
+                return static_cast<int>(r);
+            }
+        }
+    }
+    
+    // Queue and submit a read of len bytes at offset into buf
+    void read(int file, char* buf, unsigned len, uint64_t offset, uint64_t userData) {
+        unsigned tail = *sqTail;
+        unsigned index = tail & *sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = file;
+        sqe.addr = reinterpret_cast<uint64_t>(buf);
+        sqe.len = len;
+        sqe.off = offset;
+        sqe.user_data = userData;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        
+        if (enter(1, 0, 0) != 1) {
+            throw std::runtime_error("io_uring_enter failed: " + std::string(std::strerror(errno)));
+        }
+    }
+    
+    // Record every available completion in its slot
+    template<typename Slots>
+    void reap(Slots& slots) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            auto& slot = slots[static_cast<size_t>(cqe.user_data)];
+            slot.result = cqe.res;
+            slot.pending = false;
+            slot.done = true;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+    
+    void waitForCompletion() {
+        if (enter(0, 1, IORING_ENTER_GETEVENTS) < 0) {
+            throw std::runtime_error("io_uring_enter failed: " + std::string(std::strerror(errno)));
+        }
+    }
+};
+
+#else
+
+struct UringReader::Ring {};
+
+#endif
+
+UringReader::UringReader(const std::string& path, const UringOptions& options)
+    : fd_(-1),
+      bufferedFd_(-1),
+      path_(path),
+      fileSize_(0),
+      chunkSize_((std::max<size_t>(options.chunkSize, 1) + kAlignment - 1) / kAlignment * kAlignment),
+      nextOffset_(0),
+      nextSlot_(0) {
+    
+#ifdef O_DIRECT
+    if (options.direct) {
+        fd_ = open(path.c_str(), O_RDONLY | O_DIRECT);
+    }
+#endif
+    if (fd_ < 0) {
+        fd_ = open(path.c_str(), O_RDONLY);
+    }
+    if (fd_ < 0) {
+        return;
+    }
+    
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd_);
+        fd_ = -1;
+        return;
+    }
+    fileSize_ = static_cast<uint64_t>(st.st_size);
+    
+    unsigned depth = std::max(2u, options.queueDepth);  // The parser holds one chunk while the next lands
+    slots_.resize(depth);
+    for (Slot& slot : slots_) {
+        void* storage = nullptr;
+        if (posix_memalign(&storage, kAlignment, kMaxLineLength + chunkSize_) != 0) {
+            close(fd_);  // The destructor does not run for a throwing constructor
+            fd_ = -1;
+            throw std::runtime_error("Failed to allocate read buffers");
+        }
+        slot.storage = std::unique_ptr<char, void (*)(void*)>(static_cast<char*>(storage), std::free);
+        slot.chunk.data = slot.storage.get() + kMaxLineLength;
+    }
+    
+#ifdef ARTEMIS_HAVE_IO_URING
+    ring_.reset(new Ring());
+    if (!ring_->init(depth)) {
+        ring_.reset();  // Fall back to pread
+    }
+#endif
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (!ring_) {
+        posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+    
+    for (size_t i = 0; i < slots_.size() && nextOffset_ < fileSize_; ++i) {
+        submit(i);
+    }
+}
+
+UringReader::~UringReader() {
+#ifdef ARTEMIS_HAVE_IO_URING
+    // Reads must land before their buffers are freed
+    if (ring_) {
+        for (Slot& slot : slots_) {
+            while (slot.pending) {
+                ring_->reap(slots_);
+                if (slot.pending) {
+                    ring_->waitForCompletion();
+                }
+            }
+        }
+    }
+#endif
+    ring_.reset();
+    if (bufferedFd_ >= 0 && bufferedFd_ != fd_) {
+        close(bufferedFd_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+int UringReader::bufferedFd() {
+    if (bufferedFd_ < 0) {
+#ifdef O_DIRECT
+        // O_DIRECT needs aligned offsets and lengths, which a retry after a
+        // short read does not have: reopen through the page cache
+        if (fcntl(fd_, F_GETFL) & O_DIRECT) {
+            bufferedFd_ = open(path_.c_str(), O_RDONLY);
+            return bufferedFd_;
+        }
+#endif
+        bufferedFd_ = fd_;
+    }
+    return bufferedFd_;
+}
+
+void UringReader::submit(size_t index) {
+    Slot& slot = slots_[index];
+    slot.offset = nextOffset_;
+    slot.active = true;
+    slot.done = false;
+    slot.pending = false;
+    nextOffset_ += chunkSize_;
+    
+#ifdef ARTEMIS_HAVE_IO_URING
+    if (ring_) {
+        slot.pending = true;
+        ring_->read(fd_, slot.chunk.data, static_cast<unsigned>(chunkSize_), slot.offset, index);
+    }
+#endif
+}
+
+void UringReader::complete(Slot& slot) {
+#ifdef ARTEMIS_HAVE_IO_URING
+    while (slot.pending) {
+        ring_->reap(slots_);
+        if (slot.pending) {
+            ring_->waitForCompletion();
+        }
+    }
+#endif
+    
+    // pread mode, failed async reads and short reads are finished synchronously
+    size_t length = slot.done && slot.result > 0 ? static_cast<size_t>(slot.result) : 0;
+    uint64_t wanted = std::min<uint64_t>(chunkSize_, fileSize_ - slot.offset);
+    int error = 0;
+    while (length < wanted) {
+        int fd = length > 0 ? bufferedFd() : fd_;  // Unaligned after a short read
+        if (fd < 0) {
+            error = errno;
+            break;
+        }
+        ssize_t r = pread(fd, slot.chunk.data + length, chunkSize_ - length,
+                          static_cast<off_t>(slot.offset + length));
+        if (r > 0) {
+            length += static_cast<size_t>(r);
+        } else if (r < 0 && errno == EINTR) {
+            continue;
+        } else {
+            // A read error is reported through error(); EOF here means the
+            // file shrank after it was opened and ends the input cleanly
+            error = r < 0 ? errno : 0;
+            break;
+        }
+    }
+    
+    slot.done = true;
+    slot.chunk.length = length;
+    slot.chunk.error = error;
+    slot.chunk.eof = length < wanted || slot.offset + length >= fileSize_;
+}
+
+ChunkedCsvReader::Chunk* UringReader::acquire() {
+    if (fd_ < 0 || !slots_[nextSlot_].active) {
+        return nullptr;
+    }
+    
+    Slot& slot = slots_[nextSlot_];
+    complete(slot);
+    nextSlot_ = (nextSlot_ + 1) % slots_.size();
+    return &slot.chunk;
+}
+
+void UringReader::release(Chunk* chunk) {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        if (&slots_[i].chunk == chunk) {
+            slots_[i].active = false;
+            if (nextOffset_ < fileSize_) {
+                submit(i);
+            }
+            return;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ChunkedCsvReader.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct UringOptions {
+    unsigned queueDepth = 8;     // Read buffers, at least 2
+    size_t chunkSize = 1 << 20;  // Bytes per read, rounded up to 4 KiB
+    bool direct = false;         // O_DIRECT: bypass the page cache (falls back
+                                 // to buffered I/O if the filesystem refuses)
+};
+
+// CSV tick reader for files that should not be mapped (very large files,
+// network mounts). Keeps queueDepth chunk reads in flight with io_uring so
+// the device stays busy while the caller parses, instead of faulting pages
+// in one at a time. Chunks are handed to the parser in file order.
+//
+// Linux only; where io_uring is unavailable (old kernel, seccomp) the same
+// chunks are read synchronously with pread.
+class UringReader : public ChunkedCsvReader {
+public:
+    explicit UringReader(const std::string& path, const UringOptions& options = UringOptions());
+    ~UringReader() override;
+
+    // Non-copyable
+    UringReader(const UringReader&) = delete;
+    UringReader& operator=(const UringReader&) = delete;
+
+    bool isValid() const override { return fd_ >= 0; }
+
+    // True if reads go through io_uring rather than the pread fallback
+    bool isAsync() const { return ring_ != nullptr; }
+
+protected:
+    Chunk* acquire() override;
+    void release(Chunk* chunk) override;
+
+private:
+    struct Slot {
+        std::unique_ptr<char, void (*)(void*)> storage{nullptr, nullptr};
+        Chunk chunk;
+        uint64_t offset = 0;
+        int64_t result = 0;     // Bytes read or -errno, valid once done
+        bool active = false;    // Assigned a chunk of the file
+        bool pending = false;   // Read queued in the ring
+        bool done = false;      // Completion seen
+    };
+
+    struct Ring;  // io_uring state, absent in pread mode
+
+    int fd_;
+    int bufferedFd_;            // fd_, or a page-cache fd when fd_ is O_DIRECT; opened on first retry
+    std::string path_;
+    uint64_t fileSize_;
+    size_t chunkSize_;
+    uint64_t nextOffset_;       // File offset of the next read to issue
+    size_t nextSlot_;           // Slot holding the next chunk in file order
+    std::vector<Slot> slots_;
+    std::unique_ptr<Ring> ring_;
+
+    void submit(size_t index);
+    void complete(Slot& slot);  // Wait for the slot's read, finishing it with pread if needed
+    int bufferedFd();
+};
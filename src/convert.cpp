@@ -0,0 +1,84 @@
+#include "MarketDataReader.hpp"
+#include "TickFile.hpp"
+#include "TickStore.hpp"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// One-time CSV -> native binary tick file converter. The output format
+// follows the extension: .atc for the compressed column store, otherwise .atk.
+// Input "-" reads CSV from stdin (e.g. zstdcat day.csv.zst | artemis_convert - day.atk).
+// Usage: artemis_convert <input> <output.atk|output.atc> [instrument] [tick_size]
+template<typename Writer>
+uint64_t convert(TickSource& reader, const std::string& outputFile,
+                 const std::string& instrument, double tickSize) {
+    Writer writer(outputFile, instrument, tickSize);
+    if (!writer.isValid()) {
+        throw std::runtime_error("Failed to open output file: " + outputFile);
+    }
+
+    std::vector<Tick> batch(4096);
+    uint64_t count = 0;
+    size_t n;
+    while ((n = reader.nextBatch(batch.data(), batch.size())) > 0) {
+        writer.write(batch.data(), n);
+        count += n;
+    }
+    if (reader.error()) {
+        // Don't leave a truncated file that looks like a good conversion
+        writer.close();
+        std::remove(outputFile.c_str());
+        throwIfReadFailed(reader, "input");
+    }
+
+    if (!writer.close()) {
+        throw std::runtime_error("Failed to write output file: " + outputFile);
+    }
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        spdlog::error("Usage: {} <input> <output.atk|output.atc> [instrument] [tick_size]", argv[0]);
+        return 1;
+    }
+
+    std::string inputFile = argv[1];
+    std::string outputFile = argv[2];
+    std::string instrument = argc > 3 ? argv[3] : "ES";
+    double tickSize = 0.25;
+
+    try {
+        if (argc > 4) {
+            tickSize = std::stod(argv[4]);
+        }
+
+        std::unique_ptr<TickSource> reader = openTickSource(inputFile);
+        if (!reader->isValid()) {
+            throw std::runtime_error("Failed to open data file: " + inputFile);
+        }
+
+        bool columnar = outputFile.size() > 4 &&
+                        outputFile.compare(outputFile.size() - 4, 4, ".atc") == 0;
+        uint64_t count = columnar ? convert<ColumnarTickWriter>(*reader, outputFile, instrument, tickSize)
+                                  : convert<TickFileWriter>(*reader, outputFile, instrument, tickSize);
+
+        // Read back to make sure the file maps, checksums and decodes cleanly
+        MarketDataReader check(outputFile);
+        auto expected = columnar ? MarketDataReader::Format::Columnar : MarketDataReader::Format::Binary;
+        if (check.format() != expected || !check.verifyChecksum() ||
+            check.approximateTickCount() != count) {
+            throw std::runtime_error("Verification failed for: " + outputFile);
+        }
+
+        spdlog::info("Converted {} ticks: {} -> {}", count, inputFile, outputFile);
+    } catch (const std::exception& e) {
+        spdlog::error("Error: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "Backtester.hpp"
 #include "Performance.hpp"
+#include "TickCache.hpp"
 #include <spdlog/spdlog.h>
 #include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -11,6 +12,8 @@
 #include <chrono>
 #include <iomanip>
 #include <stdexcept>
+#include <limits>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -57,6 +60,16 @@ int main(int argc, char* argv[]) {
         threshold = std::stod(argv[2]);
     }
     
+    // Optional replay window [from, to) in microseconds since epoch
+    int64_t from = std::numeric_limits<int64_t>::min();
+    int64_t to = std::numeric_limits<int64_t>::max();
+    if (argc > 3) {
+        from = std::stoll(argv[3]);
+    }
+    if (argc > 4) {
+        to = std::stoll(argv[4]);
+    }
+    
     spdlog::info("Starting Artemis backtester");
     spdlog::info("Data file: {}", dataFile);
     spdlog::info("Threshold: {}", threshold);
@@ -65,8 +78,76 @@ int main(int argc, char* argv[]) {
         // Run backtest
         Backtester backtester(2.10, 1.0);  // $2.10 commission, 1 tick slippage
         
+        // ARTEMIS_IO=uring reads CSV with io_uring instead of mapping it
+        const char* io = std::getenv("ARTEMIS_IO");
+        if (io && std::string(io) == "uring") {
+            backtester.setIoBackend(IoBackend::Uring);
+        }
+        
+        // ARTEMIS_MMAP=populate,hugepage,readahead[=<MiB>],willneed,random
+        // tunes how the mapped reader touches the file (see MapOptions)
+        const char* mmap = std::getenv("ARTEMIS_MMAP");
+        if (mmap && *mmap) {
+            backtester.setMapOptions(MapOptions::parse(mmap));
+            spdlog::info("Mapping: {}", mmap);
+        }
+        
+        // ARTEMIS_STATS=sliding uses an exact sliding window for the
+        // z-score instead of the EWMA
+        const char* statsMode = std::getenv("ARTEMIS_STATS");
+        if (statsMode && std::string(statsMode) == "sliding") {
+            backtester.setStatisticsMode(StatisticsMode::Sliding);
+            spdlog::info("Statistics: sliding window");
+        }
+
+        // ARTEMIS_BARS=1m trades bar closes instead of every tick, with a
+        // z-score window of ARTEMIS_BAR_WINDOW bars (default 100)
+        const char* bars = std::getenv("ARTEMIS_BARS");
+        if (bars && *bars) {
+            const char* window = std::getenv("ARTEMIS_BAR_WINDOW");
+            backtester.setBars(BarSpec::parse(bars), window ? std::stoul(window) : 100);
+            spdlog::info("Bars: {}", bars);
+        }
+        
+        // ARTEMIS_SESSIONS=rth|eth|<calendar file> replays only session
+        // hours; ARTEMIS_SESSION_BOUNDARY=reset flattens and restarts the
+        // statistics at each session instead of carrying them over
+        const char* sessions = std::getenv("ARTEMIS_SESSIONS");
+        if (sessions && *sessions) {
+            const char* boundary = std::getenv("ARTEMIS_SESSION_BOUNDARY");
+            bool reset = boundary && std::string(boundary) == "reset";
+            backtester.setSessions(SessionCalendar::fromSpec(sessions),
+                                   reset ? SessionBoundary::Reset : SessionBoundary::Carry);
+            spdlog::info("Sessions: {} ({})", sessions, reset ? "reset" : "carry");
+        }
+        
+        // ARTEMIS_FEATURE_CACHE=1 keeps mids, EWMA state and bars in
+        // <data file>.features/ so later runs skip replaying the ticks
+        const char* features = std::getenv("ARTEMIS_FEATURE_CACHE");
+        bool featureCache = features && std::string(features) == "1";
+        backtester.setFeatureCache(featureCache);
+        
+        // ARTEMIS_CACHE=shm replays CSV from a decoded copy in /dev/shm
+        // (or $ARTEMIS_CACHE_DIR), parsed once and shared by later runs.
+        // Not needed when features are cached next to the data file.
+        const char* cache = std::getenv("ARTEMIS_CACHE");
+        if (cache && std::string(cache) == "shm" && !featureCache) {
+            TickCache tickCache;
+            if (!tickCache.isAvailable()) {
+                spdlog::warn("Tick cache directory {} not found, reading {} directly",
+                             tickCache.directory(), dataFile);
+            } else {
+                try {
+                    dataFile = tickCache.attach(dataFile);
+                    spdlog::info("Tick cache: {}", dataFile);
+                } catch (const std::runtime_error& e) {
+                    spdlog::warn("{}; reading {} directly", e.what(), dataFile);
+                }
+            }
+        }
+        
         auto startTime = std::chrono::high_resolution_clock::now();
-        PerformanceMetrics metrics = backtester.run(dataFile, threshold);
+        PerformanceMetrics metrics = backtester.run(dataFile, threshold, from, to);
         auto endTime = std::chrono::high_resolution_clock::now();
         
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
@@ -91,6 +172,12 @@ int main(int argc, char* argv[]) {
         std::cout << "Processing Time: " << totalTimeSeconds << " seconds\n";
         std::cout << "Avg Latency: " << (totalTimeSeconds * 1e6 / metrics.totalTicks) << " µs/tick\n";
         
+        const ValidationStats& quality = backtester.getValidationStats();
+        spdlog::info("Data quality: {} crossed, {} locked, {} bad price, {} out of order; "
+                     "{} dropped, {} repaired",
+                     quality.crossed, quality.locked, quality.badPrice, quality.outOfOrder,
+                     quality.dropped, quality.repaired);
+        
         spdlog::info("Backtest completed successfully");
         spdlog::info("Sharpe: {}, Max DD: {}, Throughput: {} ticks/min",
                      metrics.sharpeRatio, metrics.maxDrawdown,
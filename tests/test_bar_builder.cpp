@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "BarBuilder.hpp"
+#include "Backtester.hpp"
+#include "PackedTicks.hpp"
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+Tick quote(int64_t timestamp, double bid, int64_t volume) {
+    return Tick{timestamp, bid, bid + 0.25, volume};
+}
+
+}  // namespace
+
+TEST(BarBuilderTest, ParsesSpecs) {
+    BarSpec minute = BarSpec::parse("1m");
+    EXPECT_EQ(minute.type, BarType::Time);
+    EXPECT_DOUBLE_EQ(minute.size, 60e6);
+    EXPECT_DOUBLE_EQ(BarSpec::parse("30s").size, 30e6);
+    EXPECT_EQ(BarSpec::parse("5000v").type, BarType::Volume);
+    EXPECT_EQ(BarSpec::parse("2.5e6d").type, BarType::Dollar);
+    EXPECT_DOUBLE_EQ(BarSpec::parse("2.5e6d").size, 2.5e6);
+    EXPECT_THROW(BarSpec::parse("1x"), std::invalid_argument);
+    EXPECT_THROW(BarSpec::parse("m"), std::invalid_argument);
+    EXPECT_THROW(BarSpec::parse("0s"), std::invalid_argument);
+}
+
+TEST(BarBuilderTest, TimeBarsFollowClockIntervals) {
+    std::vector<Tick> ticks = {
+        quote(1000000, 100.00, 1),  // [1 s, 2 s)
+        quote(1500000, 101.00, 2),
+        quote(1900000, 99.00, 3),
+        quote(2100000, 100.50, 4),  // [2 s, 3 s)
+        quote(5000000, 102.00, 5),  // [5 s, 6 s): empty intervals emit nothing
+    };
+    BarBuilder builder(BarSpec::parse("1s"));
+    std::vector<Bar> bars;
+    EXPECT_EQ(builder.add(ticks.data(), ticks.size(), bars), 2u);
+    ASSERT_EQ(bars.size(), 2u);
+    
+    EXPECT_EQ(bars[0].timestamp, 1900000);
+    EXPECT_DOUBLE_EQ(bars[0].open, 100.125);
+    EXPECT_DOUBLE_EQ(bars[0].high, 101.125);
+    EXPECT_DOUBLE_EQ(bars[0].low, 99.125);
+    EXPECT_DOUBLE_EQ(bars[0].close, 99.125);
+    EXPECT_EQ(bars[0].volume, 6);
+    EXPECT_EQ(bars[1].volume, 4);
+    
+    Bar last;
+    ASSERT_TRUE(builder.flush(last));
+    EXPECT_EQ(last.timestamp, 5000000);
+    EXPECT_EQ(last.volume, 5);
+    EXPECT_FALSE(builder.flush(last));
+}
+
+TEST(BarBuilderTest, VolumeAndDollarThresholds) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < 10; ++i) {
+        ticks.push_back(quote(i, 100.00, 3));
+    }
+    
+    // 3 contracts per tick: every 4th tick reaches 10 (12 >= 10)
+    BarBuilder volume(BarSpec::parse("10v"));
+    std::vector<Bar> bars;
+    EXPECT_EQ(volume.add(ticks.data(), ticks.size(), bars), 2u);
+    EXPECT_EQ(bars[0].timestamp, 3);
+    EXPECT_EQ(bars[0].volume, 12);
+    EXPECT_EQ(bars[1].timestamp, 7);
+    
+    // 100.125 * 3 per tick: three ticks reach 900
+    BarBuilder dollar(BarSpec::parse("900d"));
+    bars.clear();
+    EXPECT_EQ(dollar.add(ticks.data(), ticks.size(), bars), 3u);
+    EXPECT_EQ(bars[0].timestamp, 2);
+    EXPECT_EQ(bars[2].timestamp, 8);
+}
+
+TEST(BarBuilderTest, BuildsFromSourceInBatches) {
+    PackedTicks packed;
+    for (int64_t i = 0; i < 20000; ++i) {
+        packed.append(quote(i * 10000, 4500.00 + 0.25 * static_cast<double>(i % 5), 1));
+    }
+    PackedTickReader reader(packed);
+    std::vector<Bar> bars = BarBuilder::build(reader, BarSpec::parse("1s"));
+    
+    // 200 s of ticks at 100 per second
+    ASSERT_EQ(bars.size(), 200u);
+    for (const Bar& bar : bars) {
+        EXPECT_EQ(bar.volume, 100);
+        EXPECT_DOUBLE_EQ(bar.low, 4500.125);
+        EXPECT_DOUBLE_EQ(bar.high, 4501.125);
+    }
+}
+
+TEST(BarBuilderTest, BacktesterTradesBarCloses) {
+    // Triangle wave 10 ticks high with a 200 s period, slow enough that
+    // 10 s bars see the same swings as ticks
+    PackedTicks packed;
+    for (int64_t i = 0; i < 60000; ++i) {
+        int64_t phase = i % 2000;
+        int64_t offset = phase < 1000 ? phase / 100 : 20 - phase / 100;
+        packed.append(quote(i * 100000, 4500.00 + 0.25 * static_cast<double>(offset), 1));
+    }
+    PackedTickReader reader(packed);
+    std::vector<Bar> bars = BarBuilder::build(reader, BarSpec::parse("10s"));
+    ASSERT_EQ(bars.size(), 600u);
+    
+    Backtester backtester(0.0, 0.0);
+    PerformanceMetrics metrics = backtester.run(bars, 1.0, 20);
+    EXPECT_EQ(metrics.totalTicks, 600u);
+    EXPECT_GT(metrics.totalTrades, 0u);
+    for (const Trade& trade : backtester.getTrades()) {
+        EXPECT_LE(trade.entryTime, trade.exitTime);
+    }
+    
+    // setBars routes a tick source through the same path
+    reader.reset();
+    backtester.setBars(BarSpec::parse("10s"), 20);
+    PerformanceMetrics viaSource = backtester.run(reader, 1.0);
+    EXPECT_EQ(viaSource.totalTicks, metrics.totalTicks);
+    EXPECT_EQ(viaSource.totalTrades, metrics.totalTrades);
+    EXPECT_DOUBLE_EQ(viaSource.totalReturn, metrics.totalReturn);
+    
+    EXPECT_THROW(backtester.run(bars, 1.0, 0), std::invalid_argument);
+}
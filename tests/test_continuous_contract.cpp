@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "ContinuousContract.hpp"
+#include "TestUtil.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kDay = 86400000000LL;
+
+// One tick per hour over [firstDay, lastDay) at a constant mid, with the
+// given volume
+std::vector<Tick> contractTicks(int firstDay, int lastDay, double mid, int64_t volume) {
+    std::vector<Tick> ticks;
+    for (int day = firstDay; day < lastDay; ++day) {
+        for (int hour = 0; hour < 24; ++hour) {
+            ticks.push_back(Tick{day * kDay + hour * 3600000000LL, mid - 0.125, mid + 0.125, volume});
+        }
+    }
+    return ticks;
+}
+
+class ContinuousContractTest : public TempDirTest {};
+
+}  // namespace
+
+TEST_F(ContinuousContractTest, FixedDateBackAdjusted) {
+    // H trades days 0-9 at 4500, M days 5-14 at 4510, U days 10-19 at 4530
+    writeCsv(path("es_h.csv"), contractTicks(0, 10, 4500.0, 1000));
+    writeCsv(path("es_m.csv"), contractTicks(5, 15, 4510.0, 100));
+    writeCsv(path("es_u.csv"), contractTicks(10, 20, 4530.0, 100));
+    
+    RollSchedule schedule;
+    schedule.method = RollSchedule::Method::FixedDate;
+    schedule.rollTimes = {8 * kDay, 13 * kDay};
+    ContinuousContract series({path("es_h.csv"), path("es_m.csv"), path("es_u.csv")}, schedule);
+    ASSERT_TRUE(series.isValid());
+    ASSERT_DOUBLE_EQ(series.adjustments()[0], 30.0);
+    ASSERT_DOUBLE_EQ(series.adjustments()[1], 20.0);
+    ASSERT_DOUBLE_EQ(series.adjustments()[2], 0.0);
+    
+    std::vector<Tick> ticks = readAllTicks(series);
+    ASSERT_EQ(ticks.size(), 20u * 24u);  // One contract per hour, no gaps or repeats
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ASSERT_EQ(ticks[i].timestamp, static_cast<int64_t>(i) * 3600000000LL);
+        ASSERT_DOUBLE_EQ(ticks[i].mid(), 4530.0) << "tick " << i;  // Continuous through both rolls
+    }
+    ASSERT_EQ(ticks[8 * 24 - 1].volume, 1000);
+    ASSERT_EQ(ticks[8 * 24].volume, 100);
+    
+    // Unadjusted keeps the raw prices and the gaps
+    schedule.backAdjust = false;
+    ContinuousContract raw({path("es_h.csv"), path("es_m.csv"), path("es_u.csv")}, schedule);
+    ticks = readAllTicks(raw);
+    ASSERT_DOUBLE_EQ(ticks.front().mid(), 4500.0);
+    ASSERT_DOUBLE_EQ(ticks[8 * 24].mid(), 4510.0);
+    ASSERT_DOUBLE_EQ(ticks.back().mid(), 4530.0);
+}
+
+TEST_F(ContinuousContractTest, VolumeCrossoverManifest) {
+    // Front volume fades over the overlap; next out-trades it on day 7
+    {
+        std::ofstream out(path("roll_h.csv"));
+        out << "timestamp,bid,ask,volume\n";
+        for (int day = 0; day < 10; ++day) {
+            out << day * kDay + 1000 << ",4500.00,4500.25," << (day < 7 ? 5000 : 50) << "\n";
+        }
+    }
+    writeCsv(path("roll_m.csv"), contractTicks(5, 12, 4504.125, 100));
+    {
+        std::ofstream manifest(path("roll.roll"));
+        manifest << "# front month first\nroll_h.csv\nroll_m.csv\n";
+    }
+    
+    ASSERT_TRUE(ContinuousContract::isRollManifest(path("roll.roll")));
+    auto series = ContinuousContract::fromManifest(path("roll.roll"));
+    ASSERT_TRUE(series->isValid());
+    ASSERT_EQ(series->rollTimes().size(), 1u);
+    ASSERT_EQ(series->rollTimes()[0], 8 * kDay);  // Known at the end of day 7
+    ASSERT_DOUBLE_EQ(series->adjustments()[0], 4.0);
+    
+    std::vector<Tick> ticks = readAllTicks(*series);
+    ASSERT_EQ(ticks.size(), 8u + 4u * 24u);
+    ASSERT_EQ(ticks[7].timestamp, 7 * kDay + 1000);
+    ASSERT_EQ(ticks[8].timestamp, 8 * kDay);
+    for (const Tick& tick : ticks) {
+        ASSERT_LE(tick.bid, tick.ask);
+    }
+    
+    // Replay window and a mismatched manifest
+    auto window = ContinuousContract::fromManifest(path("roll.roll"), 7 * kDay, 9 * kDay);
+    ASSERT_EQ(readAllTicks(*window).size(), 1u + 24u);
+    {
+        std::ofstream manifest(path("roll_bad.roll"));
+        manifest << "roll_h.csv 100\nroll_m.csv 200\n";
+    }
+    ASSERT_FALSE(ContinuousContract::fromManifest(path("roll_bad.roll"))->isValid());
+}
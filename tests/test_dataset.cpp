@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "Dataset.hpp"
+#include "TickFile.hpp"
+#include "TestUtil.hpp"
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Ticks at start, start + step, ... with the file index in the volume
+std::vector<Tick> taggedTicks(int64_t start, int64_t step, int count, int64_t tag) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < count; ++i) {
+        ticks.push_back(Tick{start + i * step, 4500.25, 4500.50, tag});
+    }
+    return ticks;
+}
+
+class DatasetTest : public TempDirTest {};
+
+}  // namespace
+
+TEST_F(DatasetTest, ConcatenatesDisjointFiles) {
+    // Named out of time order; replay follows the timestamps
+    writeCsv(path("b.csv"), taggedTicks(2000000, 10, 500, 2));
+    writeCsv(path("a.csv"), taggedTicks(1000000, 10, 500, 1));
+    writeCsv(path("c.csv"), taggedTicks(3000000, 10, 500, 3));
+    
+    Dataset dataset(dir_);
+    ASSERT_TRUE(dataset.isValid());
+    ASSERT_EQ(dataset.fileCount(), 3u);
+    ASSERT_EQ(dataset.segmentCount(), 3u);
+    ASSERT_GE(dataset.tickCount(), 1500u);
+    
+    std::vector<Tick> ticks = readAllTicks(dataset, 64);
+    ASSERT_EQ(ticks.size(), 1500u);
+    ASSERT_EQ(ticks[0].volume, 1);
+    ASSERT_EQ(ticks[500].volume, 2);
+    ASSERT_EQ(ticks[1000].volume, 3);
+    for (size_t i = 1; i < ticks.size(); ++i) {
+        ASSERT_LE(ticks[i - 1].timestamp, ticks[i].timestamp);
+    }
+}
+
+TEST_F(DatasetTest, MergesOverlappingFiles) {
+    // Three instruments on interleaved clocks, plus a later disjoint day
+    writeCsv(path("es.csv"), taggedTicks(1000000, 3, 1000, 1));
+    writeCsv(path("nq.csv"), taggedTicks(1000001, 5, 700, 2));
+    writeCsv(path("cl.csv"), taggedTicks(1000000, 7, 400, 3));  // Ties with es at 1000000, ...
+    writeCsv(path("es_next.csv"), taggedTicks(9000000, 1, 100, 4));
+    
+    Dataset dataset(path("*.csv"));
+    ASSERT_TRUE(dataset.isValid());
+    ASSERT_EQ(dataset.fileCount(), 4u);
+    ASSERT_EQ(dataset.segmentCount(), 2u);
+    
+    std::vector<Tick> ticks = readAllTicks(dataset, 37);
+    ASSERT_EQ(ticks.size(), 2200u);
+    for (size_t i = 1; i < ticks.size(); ++i) {
+        ASSERT_LE(ticks[i - 1].timestamp, ticks[i].timestamp) << "tick " << i;
+    }
+    // Same-timestamp ticks keep a fixed file order, matching next()
+    Dataset again(path("*.csv"));
+    Tick tick;
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        ASSERT_TRUE(again.next(tick));
+        ASSERT_EQ(tick.timestamp, ticks[i].timestamp);
+        ASSERT_EQ(tick.volume, ticks[i].volume);
+    }
+    ASSERT_FALSE(again.next(tick));
+    
+    size_t nq = std::count_if(ticks.begin(), ticks.end(), [](const Tick& t) { return t.volume == 2; });
+    ASSERT_EQ(nq, 700u);
+}
+
+TEST_F(DatasetTest, ManifestRangeAndMixedFormats) {
+    writeCsv(path("day1.csv"), taggedTicks(1000000, 1000, 100, 1));  // [1.0s, 1.1s)
+    writeCsv(path("day2.csv"), taggedTicks(2000000, 1000, 100, 2));
+    writeCsv(path("day3.csv"), taggedTicks(3000000, 1000, 100, 3));
+    {
+        TickFileWriter writer(path("day4.atk"));
+        for (int i = 0; i < 100; ++i) {
+            writer.write(Tick{4000000 + i * 1000, 4500.25, 4500.50, 4});
+        }
+    }
+    {
+        std::ofstream manifest(path("days.txt"));
+        manifest << "# ES sessions\n\nday1.csv\n  day2.csv\nday3.csv\nday4.atk\n";
+    }
+    
+    std::vector<std::string> files = Dataset::resolve(path("days.txt"));
+    ASSERT_EQ(files.size(), 4u);
+    ASSERT_TRUE(Dataset::isDatasetSpec(path("days.txt")));
+    ASSERT_TRUE(Dataset::isDatasetSpec(dir_));
+    ASSERT_FALSE(Dataset::isDatasetSpec(path("day1.csv")));
+    
+    // Window covers the tail of day2 through the start of day4; day1 is skipped
+    Dataset dataset(files, 2050000, 4010000);
+    ASSERT_TRUE(dataset.isValid());
+    ASSERT_EQ(dataset.fileCount(), 3u);
+    
+    std::vector<Tick> ticks = readAllTicks(dataset);
+    ASSERT_EQ(ticks.size(), 50u + 100u + 10u);
+    ASSERT_EQ(ticks.front().timestamp, 2050000);
+    ASSERT_EQ(ticks.back().timestamp, 4009000);
+    ASSERT_EQ(ticks.back().volume, 4);
+}
+
+TEST_F(DatasetTest, MissingFileInvalid) {
+    writeCsv(path("a.csv"), taggedTicks(1000000, 10, 10, 1));
+    Dataset dataset(std::vector<std::string>{path("a.csv"), path("missing.csv")});
+    ASSERT_FALSE(dataset.isValid());
+    
+    Dataset empty(path("nothing_*.csv"));
+    ASSERT_FALSE(empty.isValid());
+}
@@ -4,6 +4,9 @@
 #include <cmath>
 #include <numeric>
 #include <random>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
 
 // Test EWMA against pandas implementation
 // pandas: df.ewm(span=N, adjust=False).mean()
@@ -110,3 +113,180 @@ TEST(RollingStatisticsTest, Consistency) {
     ASSERT_LT(stats.variance(), 1.0);
 }
 
+
+// Brute-force population mean/variance of the last `window` values
+static void windowMoments(const std::vector<double>& values, size_t end, size_t window,
+                          double& mean, double& variance) {
+    size_t begin = end > window ? end - window : 0;
+    double n = static_cast<double>(end - begin);
+    mean = std::accumulate(values.begin() + begin, values.begin() + end, 0.0) / n;
+    variance = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        variance += (values[i] - mean) * (values[i] - mean);
+    }
+    variance /= n;
+}
+
+TEST(RollingStatisticsTest, SlidingMatchesBruteForce) {
+    const size_t window = 50;
+    RollingStatistics stats(window, StatisticsMode::Sliding);
+    ASSERT_EQ(stats.mode(), StatisticsMode::Sliding);
+    
+    std::mt19937 gen(7);
+    std::normal_distribution<> dist(4500.0, 2.0);
+    std::vector<double> values;
+    for (size_t i = 0; i < 500; ++i) {
+        values.push_back(dist(gen));
+        stats.update(values.back());
+        
+        double mean, variance;
+        windowMoments(values, values.size(), window, mean, variance);
+        ASSERT_NEAR(stats.mean(), mean, 1e-9) << "at " << i;
+        ASSERT_NEAR(stats.variance(), variance, 1e-9) << "at " << i;
+        ASSERT_EQ(stats.isReady(), i + 1 >= window);
+    }
+}
+
+TEST(RollingStatisticsTest, SlidingForgetsOldValues) {
+    RollingStatistics stats(10, StatisticsMode::Sliding);
+    for (int i = 0; i < 10; ++i) {
+        stats.update(1000.0);
+    }
+    for (int i = 0; i < 10; ++i) {
+        stats.update(5.0);
+    }
+    
+    // The window now holds only 5s: an EWMA would still remember the 1000s
+    ASSERT_DOUBLE_EQ(stats.mean(), 5.0);
+    ASSERT_DOUBLE_EQ(stats.variance(), 0.0);
+}
+
+TEST(RollingStatisticsTest, SlidingDoesNotDriftOverLongRuns) {
+    // Prices drift far from the first value over millions of add/evict
+    // pairs; the compensated sums must still match a fresh window
+    const size_t window = 1000;
+    RollingStatistics stats(window, StatisticsMode::Sliding);
+    
+    std::mt19937 gen(11);
+    std::normal_distribution<> step(0.0, 0.25);
+    std::vector<double> values;
+    double price = 4500.0;
+    for (size_t i = 0; i < 2000000; ++i) {
+        price += step(gen) + 0.001;
+        values.push_back(price);
+        stats.update(price);
+    }
+    
+    double mean, variance;
+    windowMoments(values, values.size(), window, mean, variance);
+    ASSERT_NEAR(stats.mean(), mean, 1e-9 * std::fabs(mean));
+    ASSERT_NEAR(stats.variance(), variance, 1e-6 * variance);
+}
+
+TEST(RollingStatisticsTest, SlidingReset) {
+    RollingStatistics stats(4, StatisticsMode::Sliding);
+    for (int i = 0; i < 6; ++i) {
+        stats.update(100.0 + i);
+    }
+    stats.reset();
+    ASSERT_EQ(stats.count(), 0u);
+    
+    stats.update(1.0);
+    stats.update(3.0);
+    ASSERT_DOUBLE_EQ(stats.mean(), 2.0);
+    ASSERT_DOUBLE_EQ(stats.variance(), 1.0);
+}
+
+TEST(RollingStatisticsTest, PoliciesAgree) {
+    for (StatisticsMode mode : {StatisticsMode::Ewma, StatisticsMode::Sliding}) {
+        RollingStatistics single(37, mode);
+        ConcurrentRollingStatistics shared(37, mode);
+        
+        std::mt19937 gen(3);
+        std::normal_distribution<> dist(4500.0, 1.0);
+        for (int i = 0; i < 1000; ++i) {
+            double value = dist(gen);
+            single.update(value);
+            shared.update(value);
+            ASSERT_EQ(single.mean(), shared.mean());
+            ASSERT_EQ(single.variance(), shared.variance());
+            ASSERT_EQ(single.count(), shared.count());
+        }
+    }
+}
+
+TEST(RollingStatisticsTest, RejectsZeroWindow) {
+    EXPECT_THROW(RollingStatistics(0), std::invalid_argument);
+    EXPECT_THROW(RollingStatistics(0, StatisticsMode::Sliding), std::invalid_argument);
+    EXPECT_THROW(ConcurrentRollingStatistics(0), std::invalid_argument);
+}
+
+TEST(RollingStatisticsTest, ConcurrentCountIsMonotonic) {
+    ConcurrentRollingStatistics stats(64, StatisticsMode::Sliding);
+    const size_t total = 200000;
+    std::atomic<bool> done{false};
+    
+    std::thread reader([&] {
+        size_t last = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            size_t n = stats.count();
+            ASSERT_GE(n, last);
+            ASSERT_LE(n, total);
+            last = n;
+        }
+    });
+    
+    for (size_t i = 0; i < total; ++i) {
+        stats.update(static_cast<double>(i % 100));
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    
+    ASSERT_EQ(stats.count(), total);
+}
+
+TEST(RollingStatisticsTest, SnapshotMatchesWriterState) {
+    RollingStatistics stats(10);
+    for (int i = 0; i < 20; ++i) {
+        stats.update(100.0 + i, 1000 + i);
+    }
+    StatisticsSnapshot snapshot = stats.snapshot();
+    EXPECT_EQ(snapshot.mean, stats.mean());
+    EXPECT_EQ(snapshot.variance, stats.variance());
+    EXPECT_EQ(snapshot.count, 20u);
+    EXPECT_EQ(snapshot.timestamp, 1019);
+    
+    ConcurrentRollingStatistics shared(10);
+    shared.update(5.0, 42);
+    EXPECT_EQ(shared.snapshot().timestamp, 42);
+    shared.reset();
+    EXPECT_EQ(shared.snapshot().count, 0u);
+}
+
+TEST(RollingStatisticsTest, ConcurrentSnapshotsAreNeverTorn) {
+    // Window of one: after the k-th update mean == count == timestamp == k,
+    // so any mix of fields from two updates shows up
+    ConcurrentRollingStatistics stats(1, StatisticsMode::Sliding);
+    const int64_t total = 500000;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> reads{0};
+    
+    std::thread reader([&] {
+        do {
+            StatisticsSnapshot snapshot = stats.snapshot();
+            ASSERT_EQ(snapshot.mean, static_cast<double>(snapshot.count));
+            ASSERT_EQ(snapshot.timestamp, static_cast<int64_t>(snapshot.count));
+            ASSERT_EQ(snapshot.variance, 0.0);
+            reads.fetch_add(1, std::memory_order_relaxed);
+        } while (!done.load(std::memory_order_acquire));
+    });
+    
+    for (int64_t k = 1; k <= total; ++k) {
+        stats.update(static_cast<double>(k), k);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_EQ(stats.snapshot().count, static_cast<size_t>(total));
+}
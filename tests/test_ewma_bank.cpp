@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "EwmaBank.hpp"
+#include "RollingStatistics.hpp"
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(EwmaBankTest, MatchesRollingStatisticsPerHorizon) {
+    // Seven horizons: one full vector plus a padded one
+    std::vector<size_t> windows = {1, 5, 20, 50, 100, 200, 1000};
+    EwmaBank bank(windows);
+    ASSERT_EQ(bank.size(), windows.size());
+    
+    std::vector<std::unique_ptr<RollingStatistics>> reference;
+    for (size_t window : windows) {
+        reference.push_back(std::make_unique<RollingStatistics>(window));
+    }
+    
+    std::mt19937 gen(17);
+    std::normal_distribution<> step(0.0, 0.25);
+    double price = 4500.0;
+    for (int t = 0; t < 3000; ++t) {
+        price += step(gen);
+        bank.update(price);
+        for (size_t i = 0; i < windows.size(); ++i) {
+            reference[i]->update(price);
+            ASSERT_NEAR(bank.mean(i), reference[i]->mean(), 1e-9) << "window " << windows[i];
+            ASSERT_NEAR(bank.variance(i), reference[i]->variance(),
+                        1e-9 * (1.0 + reference[i]->variance())) << "window " << windows[i];
+            ASSERT_EQ(bank.isReady(i), reference[i]->isReady());
+        }
+    }
+}
+
+TEST(EwmaBankTest, ZScoreAndArrays) {
+    EwmaBank bank({10, 20, 40, 80, 160, 320, 640, 1280});
+    for (int i = 0; i < 2000; ++i) {
+        bank.update(100.0 + (i % 7));
+    }
+    for (size_t i = 0; i < bank.size(); ++i) {
+        EXPECT_EQ(bank.means()[i], bank.mean(i));
+        EXPECT_EQ(bank.variances()[i], bank.variance(i));
+        double z = (110.0 - bank.mean(i)) / bank.stddev(i);
+        EXPECT_DOUBLE_EQ(bank.zscore(i, 110.0), z);
+    }
+}
+
+TEST(EwmaBankTest, Reset) {
+    EwmaBank bank({3, 4});
+    for (int i = 0; i < 10; ++i) {
+        bank.update(50.0 + i);
+    }
+    bank.reset();
+    EXPECT_EQ(bank.count(), 0u);
+    EXPECT_FALSE(bank.isReady(0));
+    
+    bank.update(7.0);
+    bank.update(9.0);
+    EXPECT_DOUBLE_EQ(bank.mean(0), 8.0);
+    EXPECT_DOUBLE_EQ(bank.variance(1), 1.0);
+}
+
+TEST(EwmaBankTest, RejectsBadWindows) {
+    EXPECT_THROW(EwmaBank({}), std::invalid_argument);
+    EXPECT_THROW(EwmaBank({10, 0}), std::invalid_argument);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "FeatureCache.hpp"
+#include "Backtester.hpp"
+#include "TestUtil.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Noisy quotes with a slow drift, enough to warm a short window and trade
+std::vector<Tick> driftingTicks(int count, double offset) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < count; ++i) {
+        double bid = 4500.0 + offset + 0.25 * ((i * 7919) % 13) + 0.25 * (i / 500);
+        ticks.push_back(Tick{1700000000000000LL + i * 250000LL, bid, bid + 0.25, 1 + i % 4});
+    }
+    return ticks;
+}
+
+class FeatureCacheTest : public TempDirTest {
+protected:
+    void SetUp() override {
+        TempDirTest::SetUp();
+        csv_ = path("ticks.csv");
+        writeCsv(csv_, driftingTicks(5000, 0.0));
+    }
+    
+    std::string csv_;
+};
+
+}  // namespace
+
+TEST_F(FeatureCacheTest, BuildsThenMapsSeries) {
+    FeatureCache cache(csv_);
+    ASSERT_TRUE(cache.isValid());
+    
+    FeatureSeries<MidPoint> mids = cache.mids();
+    ASSERT_EQ(mids.size(), 5000u);
+    EXPECT_EQ(mids[0].timestamp, 1700000000000000LL);
+    EXPECT_DOUBLE_EQ(mids[0].mid, 4500.125);
+    
+    FeatureSeries<EwmaPoint> ewma = cache.ewma(100);
+    ASSERT_EQ(ewma.size(), mids.size());
+    RollingStatistics stats(100);
+    for (size_t i = 0; i < mids.size(); ++i) {
+        stats.update(mids[i].mid);
+        EXPECT_EQ(ewma[i].mean, stats.mean());
+        EXPECT_EQ(ewma[i].variance, stats.variance());
+    }
+    
+    FeatureSeries<Bar> bars = cache.bars(BarSpec::parse("10s"));
+    EXPECT_EQ(bars.size(), 125u);  // 1250 s of ticks
+    
+    // Second cache object maps the same files without rewriting them
+    fs::path midFile = fs::path(cache.directory()) / "mid.atf";
+    auto written = fs::last_write_time(midFile);
+    FeatureCache again(csv_);
+    EXPECT_EQ(again.mids().size(), 5000u);
+    EXPECT_EQ(fs::last_write_time(midFile), written);
+}
+
+TEST_F(FeatureCacheTest, RebuildsWhenSourceChanges) {
+    EXPECT_DOUBLE_EQ(FeatureCache(csv_).mids()[0].mid, 4500.125);
+    
+    writeCsv(csv_, driftingTicks(4000, 1.0));
+    fs::last_write_time(csv_, fs::last_write_time(csv_) + std::chrono::seconds(1));
+    FeatureSeries<MidPoint> mids = FeatureCache(csv_).mids();
+    EXPECT_EQ(mids.size(), 4000u);
+    EXPECT_DOUBLE_EQ(mids[0].mid, 4501.125);
+}
+
+TEST_F(FeatureCacheTest, RebuildsCorruptFile) {
+    fs::path midFile;
+    {
+        FeatureCache cache(csv_);
+        ASSERT_EQ(cache.mids().size(), 5000u);
+        midFile = fs::path(cache.directory()) / "mid.atf";
+    }
+    
+    // Flip a record byte behind the header; source and params still match
+    {
+        std::fstream file(midFile, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(FeatureFileHeader) + 8);
+        file.put('\x7f');
+    }
+    
+    FeatureSeries<MidPoint> mids = FeatureCache(csv_).mids();
+    ASSERT_EQ(mids.size(), 5000u);
+    EXPECT_DOUBLE_EQ(mids[0].mid, 4500.125);
+}
+
+TEST_F(FeatureCacheTest, ValidationOptionsAreKeyed) {
+    // A crossed quote: dropped by default, kept when only flagged
+    {
+        std::ofstream out(csv_, std::ios::app);
+        out << "1700001250000000,4600.00,4599.75,1\n";
+    }
+    ValidationOptions flag;
+    flag.crossed = TickAction::Flag;
+    EXPECT_EQ(FeatureCache(csv_).mids().size(), 5000u);
+    EXPECT_EQ(FeatureCache(csv_, flag).mids().size(), 5001u);
+}
+
+TEST_F(FeatureCacheTest, BacktestMatchesTickReplay) {
+    writeCsv(csv_, driftingTicks(40000, 0.0));  // Past the 20000-tick window
+    Backtester replay(2.10, 1.0);
+    PerformanceMetrics expected = replay.run(csv_, 1.0);
+    ASSERT_GT(expected.totalTrades, 0u);
+    
+    FeatureCache cache(csv_);
+    Backtester cached(2.10, 1.0);
+    PerformanceMetrics actual = cached.run(cache.mids(), cache.ewma(Backtester::kWindow), 1.0);
+    EXPECT_EQ(actual.totalTicks, expected.totalTicks);
+    EXPECT_EQ(actual.totalTrades, expected.totalTrades);
+    EXPECT_DOUBLE_EQ(actual.totalReturn, expected.totalReturn);
+    
+    // Same through setFeatureCache, including bars
+    Backtester viaFile(2.10, 1.0);
+    viaFile.setFeatureCache(true);
+    EXPECT_DOUBLE_EQ(viaFile.run(csv_, 1.0).totalReturn, expected.totalReturn);
+    
+    replay.setBars(BarSpec::parse("5s"), 20);
+    viaFile.setBars(BarSpec::parse("5s"), 20);
+    PerformanceMetrics barsExpected = replay.run(csv_, 1.0);
+    PerformanceMetrics barsActual = viaFile.run(csv_, 1.0);
+    EXPECT_EQ(barsActual.totalTicks, barsExpected.totalTicks);
+    EXPECT_EQ(barsActual.totalTrades, barsExpected.totalTrades);
+    EXPECT_DOUBLE_EQ(barsActual.totalReturn, barsExpected.totalReturn);
+}
+
+TEST_F(FeatureCacheTest, ValidationStatsSurviveTheCache) {
+    // Two crossed quotes and one out of order, all dropped
+    {
+        std::ofstream out(csv_, std::ios::app);
+        out << "1700001250000000,4600.00,4599.75,1\n";
+        out << "1700001250250000,4600.00,4599.50,1\n";
+        out << "1700000000000000,4500.00,4500.25,1\n";
+    }
+    Backtester replay;
+    replay.run(csv_, 1.0);
+    ValidationStats expected = replay.getValidationStats();
+    ASSERT_GT(expected.dropped, 0u);
+    
+    // Build the cache, then serve a second run from it
+    for (int run = 0; run < 2; ++run) {
+        Backtester cached;
+        cached.setFeatureCache(true);
+        cached.run(csv_, 1.0);
+        const ValidationStats& actual = cached.getValidationStats();
+        EXPECT_EQ(actual.ticks, expected.ticks) << "run " << run;
+        EXPECT_EQ(actual.crossed, expected.crossed) << "run " << run;
+        EXPECT_EQ(actual.outOfOrder, expected.outOfOrder) << "run " << run;
+        EXPECT_EQ(actual.dropped, expected.dropped) << "run " << run;
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "FixedRollingStatistics.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<double> randomWalk(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<> step(0.0, 0.25);
+    std::vector<double> values;
+    double price = 4500.0;
+    for (size_t i = 0; i < n; ++i) {
+        price += step(gen);
+        values.push_back(price);
+    }
+    return values;
+}
+
+template<StatisticsMode Mode>
+void expectSameAsRuntime() {
+    FixedRollingStatistics<100, Mode> fixed;
+    RollingStatistics runtime(100, Mode);
+    
+    for (double value : randomWalk(5000, 5)) {
+        fixed.update(value);
+        runtime.update(value);
+        ASSERT_EQ(fixed.mean(), runtime.mean());
+        ASSERT_EQ(fixed.variance(), runtime.variance());
+        ASSERT_EQ(fixed.isReady(), runtime.isReady());
+    }
+    
+    fixed.reset();
+    runtime.reset();
+    fixed.update(1.0);
+    runtime.update(1.0);
+    EXPECT_EQ(fixed.count(), 1u);
+    EXPECT_EQ(fixed.mean(), runtime.mean());
+}
+
+}  // namespace
+
+TEST(FixedRollingStatisticsTest, EwmaMatchesRuntime) {
+    expectSameAsRuntime<StatisticsMode::Ewma>();
+}
+
+TEST(FixedRollingStatisticsTest, SlidingMatchesRuntime) {
+    expectSameAsRuntime<StatisticsMode::Sliding>();
+}
+
+TEST(FixedRollingStatisticsTest, FloatPrecisionTracksDouble) {
+    FixedRollingStatistics<64, StatisticsMode::Sliding, float> single;
+    FixedRollingStatistics<64, StatisticsMode::Sliding> full;
+    
+    for (double value : randomWalk(10000, 9)) {
+        single.update(static_cast<float>(value));
+        full.update(value);
+    }
+    EXPECT_NEAR(single.mean(), full.mean(), 1e-2);
+    EXPECT_NEAR(single.variance(), full.variance(), 1e-2 * full.variance() + 1e-3);
+}
+
+TEST(FixedRollingStatisticsTest, RegistryDispatch) {
+    using Registry = StatisticsRegistry<64, 128>;
+    EXPECT_TRUE(Registry::contains(64));
+    EXPECT_FALSE(Registry::contains(100));
+    
+    auto windowOf = [](auto& stats) {
+        using Stats = std::decay_t<decltype(stats)>;
+        if constexpr (std::is_same_v<Stats, RollingStatistics>) {
+            return size_t(0);  // Runtime fallback
+        } else {
+            EXPECT_EQ(stats.mode(), Stats::kMode);
+            return Stats::kWindow;
+        }
+    };
+    EXPECT_EQ(Registry::dispatch(64, StatisticsMode::Ewma, windowOf), 64u);
+    EXPECT_EQ(Registry::dispatch(128, StatisticsMode::Sliding, windowOf), 128u);
+    EXPECT_EQ(Registry::dispatch(100, StatisticsMode::Ewma, windowOf), 0u);
+    
+    // Fallback still honours the mode
+    StatisticsMode mode = Registry::dispatch(100, StatisticsMode::Sliding,
+                                             [](auto& stats) { return stats.mode(); });
+    EXPECT_EQ(mode, StatisticsMode::Sliding);
+}
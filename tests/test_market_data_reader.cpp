@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include "MarketDataReader.hpp"
+#include "TestUtil.hpp"
 #include <fstream>
 #include <sstream>
 #include <cstdio>
+#include <vector>
 
 TEST(MarketDataReaderTest, BasicReading) {
     // Create test CSV file
@@ -183,3 +185,295 @@ TEST(MarketDataReaderTest, MalformedLines) {
     remove(testFile.c_str());
 }
 
+
+TEST(MarketDataReaderTest, NextBatch) {
+    std::string testFile = "test_batch.csv";
+    std::ofstream out(testFile);
+    out << "timestamp,bid,ask,volume\n";
+    for (int i = 0; i < 10; ++i) {
+        out << (1000000 + i) << ",4500.25,4500.50," << (100 + i) << "\n";
+        if (i == 4) {
+            out << "invalid_line\n";
+        }
+    }
+    out.close();
+    
+    MarketDataReader reader(testFile);
+    ASSERT_TRUE(reader.isValid());
+    
+    Tick batch[4];
+    ASSERT_EQ(reader.nextBatch(batch, 4), 4u);
+    ASSERT_EQ(batch[0].timestamp, 1000000);
+    ASSERT_EQ(batch[3].timestamp, 1000003);
+    
+    // Malformed line is skipped inside the batch
+    ASSERT_EQ(reader.nextBatch(batch, 4), 4u);
+    ASSERT_EQ(batch[0].timestamp, 1000004);
+    ASSERT_EQ(batch[1].timestamp, 1000005);
+    
+    ASSERT_EQ(reader.nextBatch(batch, 4), 2u);
+    ASSERT_EQ(batch[1].timestamp, 1000009);
+    ASSERT_EQ(batch[1].volume, 109);
+    
+    ASSERT_EQ(reader.nextBatch(batch, 4), 0u);  // EOF
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, NextBatchColumnar) {
+    std::string testFile = "test_batch_columnar.csv";
+    std::ofstream out(testFile);
+    out << "timestamp,bid,ask,volume\n";
+    out << "1000000,4500.25,4500.50,100\n";
+    out << "2000000,4500.75,4501.00,200\n";
+    out << "3000000,4501.25,4501.50,150\n";
+    out.close();
+    
+    MarketDataReader reader(testFile);
+    ASSERT_TRUE(reader.isValid());
+    
+    int64_t ts[8];
+    double bid[8];
+    double ask[8];
+    int64_t vol[8];
+    TickColumns cols{ts, bid, ask, vol};
+    
+    ASSERT_EQ(reader.nextBatch(cols, 8), 3u);
+    ASSERT_EQ(ts[0], 1000000);
+    ASSERT_EQ(ts[2], 3000000);
+    ASSERT_DOUBLE_EQ(bid[1], 4500.75);
+    ASSERT_DOUBLE_EQ(ask[2], 4501.50);
+    ASSERT_EQ(vol[1], 200);
+    ASSERT_EQ(reader.nextBatch(cols, 8), 0u);
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, ReadAllParallelMatchesSequential) {
+    std::string testFile = "test_read_all.csv";
+    std::ofstream out(testFile);
+    out << "timestamp,bid,ask,volume\n";
+    // ~3 MB so the file splits into several chunks
+    for (int i = 0; i < 100000; ++i) {
+        out << (1609459200000000LL + i * 1000) << "," << (4500.0 + (i % 16) * 0.25) << ","
+            << (4500.25 + (i % 16) * 0.25) << "," << (i % 300) << "\n";
+        if (i % 9999 == 0) {
+            out << "invalid_line\n";
+        }
+    }
+    out.close();
+    
+    MarketDataReader sequential(testFile);
+    std::vector<Tick> expected;
+    Tick tick;
+    while (sequential.next(tick)) {
+        expected.push_back(tick);
+    }
+    ASSERT_EQ(expected.size(), 100000u);
+    
+    for (unsigned threads : {1u, 3u, 8u}) {
+        MarketDataReader reader(testFile);
+        std::vector<Tick> ticks = reader.readAll(threads);
+        ASSERT_EQ(ticks.size(), expected.size());
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            ASSERT_EQ(ticks[i].timestamp, expected[i].timestamp);
+            ASSERT_EQ(ticks[i].bid, expected[i].bid);
+            ASSERT_EQ(ticks[i].volume, expected[i].volume);
+        }
+        ASSERT_FALSE(reader.next(tick));  // Consumed
+    }
+    
+    remove(testFile.c_str());
+}
+
+namespace {
+
+// 5000 ticks, two per timestamp at 1000us spacing, with a few bad lines
+std::string writeSeekFile(const std::string& testFile) {
+    std::ofstream out(testFile);
+    out << "timestamp,bid,ask,volume\n";
+    for (int i = 0; i < 5000; ++i) {
+        int64_t ts = 1000000 + (i / 2) * 1000;
+        out << ts << ",4500.25,4500.50," << i << "\n";
+        if (i % 777 == 0) {
+            out << "invalid_line\n";
+        }
+    }
+    return testFile;
+}
+
+int64_t firstTimestampFrom(MarketDataReader& reader, int64_t target) {
+    Tick tick;
+    if (!reader.seek(target) || !reader.next(tick)) {
+        return -1;
+    }
+    return tick.timestamp;
+}
+
+}  // namespace
+
+TEST(MarketDataReaderTest, SeekCsv) {
+    std::string testFile = writeSeekFile("test_seek.csv");
+    MarketDataReader reader(testFile);
+    ASSERT_TRUE(reader.isValid());
+    
+    ASSERT_EQ(firstTimestampFrom(reader, 0), 1000000);
+    ASSERT_EQ(firstTimestampFrom(reader, 1000000), 1000000);
+    ASSERT_EQ(firstTimestampFrom(reader, 1000001), 1001000);
+    ASSERT_EQ(firstTimestampFrom(reader, 2345678), 2346000);
+    ASSERT_EQ(firstTimestampFrom(reader, 3499000), 3499000);
+    ASSERT_EQ(firstTimestampFrom(reader, 3499001), -1);
+    
+    // Every seek lands on the first of the duplicates (volume = tick number)
+    for (int i = 0; i < 5000; i += 123) {
+        int64_t ts = 1000000 + (i / 2) * 1000;
+        Tick tick;
+        ASSERT_TRUE(reader.seek(ts));
+        ASSERT_TRUE(reader.next(tick));
+        ASSERT_EQ(tick.volume, i - i % 2);
+    }
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, TimeRange) {
+    std::string testFile = writeSeekFile("test_range.csv");
+    
+    MarketDataReader reader(testFile, 2000000, 2010000);
+    ASSERT_TRUE(reader.isValid());
+    
+    Tick batch[64];
+    size_t n = reader.nextBatch(batch, 64);
+    ASSERT_EQ(n, 20u);
+    ASSERT_EQ(batch[0].timestamp, 2000000);
+    ASSERT_EQ(batch[n - 1].timestamp, 2009000);
+    ASSERT_EQ(reader.nextBatch(batch, 64), 0u);
+    
+    // reset() returns to the start of the range
+    reader.reset();
+    Tick tick;
+    int count = 0;
+    while (reader.next(tick)) {
+        ASSERT_GE(tick.timestamp, 2000000);
+        ASSERT_LT(tick.timestamp, 2010000);
+        count++;
+    }
+    ASSERT_EQ(count, 20);
+    
+    // Empty range
+    MarketDataReader empty(testFile, 9000000, 9100000);
+    ASSERT_FALSE(empty.next(tick));
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, ExactTickCount) {
+    std::string testFile = "test_count.csv";
+    std::ofstream out(testFile, std::ios::binary);
+    out << "timestamp,bid,ask,volume\n";
+    for (int i = 0; i < 12345; ++i) {
+        out << (1000000 + i) << ",4500.25,4500.50,100\n";
+    }
+    out << "1012345,4500.25,4500.50,100";  // No trailing newline
+    out.close();
+    
+    MarketDataReader reader(testFile);
+    ASSERT_EQ(reader.tickCount(), 12346u);
+    ASSERT_EQ(reader.tickCount(), 12346u);  // Cached
+    ASSERT_TRUE(reader.atStart());
+    
+    size_t count = 0;
+    Tick tick;
+    while (reader.next(tick)) {
+        count++;
+    }
+    ASSERT_EQ(count, reader.tickCount());
+    ASSERT_FALSE(reader.atStart());
+    reader.reset();
+    ASSERT_TRUE(reader.atStart());
+    
+    // A range counts the whole file but replays only part of it
+    MarketDataReader ranged(testFile, 1000100, 1000200);
+    ASSERT_EQ(ranged.tickCount(), 12346u);
+    ASSERT_FALSE(ranged.atStart());
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, TickCountEdgeCases) {
+    std::string testFile = "test_count_edge.csv";
+    {
+        std::ofstream out(testFile);
+        out << "timestamp,bid,ask,volume\n";
+    }
+    ASSERT_EQ(MarketDataReader(testFile).tickCount(), 0u);
+    {
+        std::ofstream out(testFile, std::ios::binary);
+        out << "timestamp,bid,ask,volume\r\n1000000,4500.25,4500.50,100\r\n";
+    }
+    ASSERT_EQ(MarketDataReader(testFile).tickCount(), 1u);
+    ASSERT_EQ(MarketDataReader("nonexistent_file.csv").tickCount(), 0u);
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, MapOptions) {
+    std::string testFile = "test_map_options.csv";
+    std::ofstream out(testFile);
+    out << "timestamp,bid,ask,volume\n";
+    for (int i = 0; i < 50000; ++i) {
+        out << (1000000 + i) << ",4500.25,4500.50," << i << "\n";
+    }
+    out.close();
+    
+    MapOptions options;
+    options.sequential = true;
+    options.willNeed = true;
+    options.populate = true;
+    options.hugePages = true;
+    options.readaheadBytes = 64 * 1024;
+    
+    MarketDataReader reader(testFile, options);
+    ASSERT_TRUE(reader.isValid());
+    
+    std::vector<Tick> batch(1000);
+    int64_t expected = 0;
+    size_t n;
+    while ((n = reader.nextBatch(batch.data(), batch.size())) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(batch[i].volume, expected++);
+        }
+    }
+    ASSERT_EQ(expected, 50000);
+    
+    // Moving keeps the readahead thread valid; destruction joins it
+    MarketDataReader moved(std::move(reader));
+    moved.reset();
+    Tick tick;
+    ASSERT_TRUE(moved.next(tick));
+    ASSERT_EQ(tick.volume, 0);
+    
+    // The worker exited at EOF above; reset() and seek() start a new pass
+    moved.reset();
+    ASSERT_EQ(readAllTicks(moved, 1000).size(), 50000u);
+    ASSERT_TRUE(moved.seek(1000000 + 25000));
+    ASSERT_EQ(readAllTicks(moved, 1000).size(), 25000u);
+    
+    remove(testFile.c_str());
+}
+
+TEST(MarketDataReaderTest, MapOptionsParse) {
+    MapOptions none = MapOptions::parse("");
+    ASSERT_FALSE(none.populate);
+    ASSERT_EQ(none.readaheadBytes, 0u);
+    
+    MapOptions options = MapOptions::parse("populate,hugepage,readahead");
+    ASSERT_TRUE(options.populate);
+    ASSERT_TRUE(options.hugePages);
+    ASSERT_FALSE(options.willNeed);
+    ASSERT_EQ(options.readaheadBytes, 64u << 20);
+    
+    ASSERT_EQ(MapOptions::parse("readahead=8").readaheadBytes, 8u << 20);
+    ASSERT_FALSE(MapOptions::parse("random,willneed").sequential);
+    ASSERT_THROW(MapOptions::parse("populate,bogus"), std::invalid_argument);
+}
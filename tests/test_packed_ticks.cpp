@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "PackedTicks.hpp"
+#include "MarketDataReader.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<Tick> makeTicks(size_t count) {
+    std::vector<Tick> ticks;
+    for (size_t i = 0; i < count; ++i) {
+        double bid = 4500.0 + 0.25 * static_cast<double>(i % 40);
+        ticks.push_back(Tick{1700000000000000LL + static_cast<int64_t>(i) * 1500, bid, bid + 0.25,
+                             static_cast<int64_t>(1 + i % 17)});
+    }
+    return ticks;
+}
+
+void expectSameTicks(const Tick& a, const Tick& b) {
+    EXPECT_EQ(a.timestamp, b.timestamp);
+    EXPECT_EQ(a.bid, b.bid);
+    EXPECT_EQ(a.ask, b.ask);
+    EXPECT_EQ(a.volume, b.volume);
+}
+
+}  // namespace
+
+TEST(PackedTicksTest, RoundTripsAcrossBlocks) {
+    std::vector<Tick> ticks = makeTicks(PackedTicks::kBlockSize * 2 + 100);
+    PackedTicks packed;
+    packed.append(ticks.data(), ticks.size());
+    
+    ASSERT_EQ(packed.size(), ticks.size());
+    for (size_t i = 0; i < ticks.size(); i += 97) {
+        expectSameTicks(packed[i], ticks[i]);
+    }
+    
+    // Bulk unpack straddling a block boundary
+    std::vector<Tick> out(500);
+    size_t n = packed.unpack(PackedTicks::kBlockSize - 250, out.data(), out.size());
+    ASSERT_EQ(n, out.size());
+    for (size_t i = 0; i < n; ++i) {
+        expectSameTicks(out[i], ticks[PackedTicks::kBlockSize - 250 + i]);
+    }
+    EXPECT_EQ(packed.unpack(ticks.size() - 10, out.data(), out.size()), 10u);
+    EXPECT_EQ(packed.unpack(ticks.size(), out.data(), out.size()), 0u);
+    
+    // Half the size of Tick plus a little block overhead
+    EXPECT_LT(packed.memoryBytes(), ticks.size() * sizeof(Tick) * 6 / 10);
+}
+
+TEST(PackedTicksTest, RebasesOnLargeGapsAndBackwardTime) {
+    std::vector<Tick> ticks = {
+        {1000, 4500.00, 4500.25, 1},
+        {1000 + 5000000000LL, 4500.25, 4500.50, 2},  // > 2^32 us later
+        {500, 4499.75, 4500.00, 3},                   // Earlier than the base
+        {600, 1.00, 1.25, 4},                         // Far below the base price
+        {700, 4500.00, 4500.25, 4294967295LL},        // Max packed volume
+    };
+    PackedTicks packed;
+    packed.append(ticks.data(), ticks.size());
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        expectSameTicks(packed[i], ticks[i]);
+    }
+}
+
+TEST(PackedTicksTest, RejectsUnrepresentableTicks) {
+    PackedTicks packed;
+    EXPECT_THROW(packed.append(Tick{1, 4500.10, 4500.25, 1}), std::invalid_argument);
+    EXPECT_THROW(packed.append(Tick{1, 4500.00, 4500.25, -1}), std::invalid_argument);
+    EXPECT_THROW(packed.append(Tick{1, 4500.00, 4500.25, 4294967296LL}), std::invalid_argument);
+    EXPECT_TRUE(packed.empty());
+    
+    PackedTicks cents(0.01);
+    EXPECT_NO_THROW(cents.append(Tick{1, 101.37, 101.38, 1}));
+    EXPECT_EQ(cents[0].bid, 101.37);
+}
+
+TEST(PackedTicksTest, LoadsFromSourceAndReplays) {
+    const char* path = "test_packed_ticks.csv";
+    std::vector<Tick> ticks = makeTicks(10000);
+    {
+        std::ofstream out(path);
+        out << "timestamp,bid,ask,volume\n";
+        out.precision(10);
+        for (const Tick& t : ticks) {
+            out << t.timestamp << "," << t.bid << "," << t.ask << "," << t.volume << "\n";
+        }
+    }
+    
+    PackedTicks packed;
+    {
+        MarketDataReader reader(path);
+        packed.load(reader);
+    }
+    std::remove(path);
+    ASSERT_EQ(packed.size(), ticks.size());
+    
+    PackedTickReader replay(packed);
+    EXPECT_EQ(replay.tickCount(), ticks.size());
+    for (int sweep = 0; sweep < 2; ++sweep) {
+        std::vector<Tick> batch(333);
+        size_t total = 0;
+        size_t n;
+        while ((n = replay.nextBatch(batch.data(), batch.size())) > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                expectSameTicks(batch[i], ticks[total + i]);
+            }
+            total += n;
+        }
+        EXPECT_EQ(total, ticks.size());
+        replay.reset();
+    }
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include "SessionCalendar.hpp"
+#include "Backtester.hpp"
+#include "MarketDataReader.hpp"
+#include "PackedTicks.hpp"
+#include "TickFile.hpp"
+#include "TestUtil.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kMinute = 60000000LL;
+constexpr int64_t kHour = 60 * kMinute;
+
+// 2024-03-04 00:00 UTC, a Monday (EST, UTC-5)
+constexpr int64_t kMonday = 1709510400000000LL;
+
+// One tick per minute for count minutes starting at start
+std::vector<Tick> minuteTicks(int64_t start, int count) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < count; ++i) {
+        ticks.push_back(Tick{start + i * kMinute, 4500.00, 4500.25, 1});
+    }
+    return ticks;
+}
+
+}  // namespace
+
+TEST(SessionCalendarTest, RegularHoursFollowDst) {
+    SessionCalendar rth = SessionCalendar::rth();
+    int64_t open, close;
+    
+    // Monday 4 March (EST): 14:30-21:00 UTC
+    ASSERT_TRUE(rth.sessionAt(kMonday, open, close));
+    EXPECT_EQ(open, kMonday + 14 * kHour + 30 * kMinute);
+    EXPECT_EQ(close, kMonday + 21 * kHour);
+    EXPECT_TRUE(rth.contains(open));
+    EXPECT_FALSE(rth.contains(close));
+    EXPECT_FALSE(rth.contains(open - 1));
+    
+    // Monday 11 March is after the switch to EDT: 13:30-20:00 UTC
+    int64_t nextMonday = kMonday + 7 * 24 * kHour;
+    ASSERT_TRUE(rth.sessionAt(nextMonday, open, close));
+    EXPECT_EQ(open, nextMonday + 13 * kHour + 30 * kMinute);
+    
+    // Friday close rolls over the weekend to Monday
+    int64_t fridayClose = kMonday + 4 * 24 * kHour + 21 * kHour;
+    ASSERT_TRUE(rth.sessionAt(fridayClose, open, close));
+    EXPECT_EQ(open, kMonday + 7 * 24 * kHour + 13 * kHour + 30 * kMinute);
+}
+
+TEST(SessionCalendarTest, ElectronicHoursStartTheEveningBefore) {
+    SessionCalendar eth = SessionCalendar::eth();
+    int64_t open, close;
+    
+    // Monday's session opens Sunday 18:00 ET (23:00 UTC) and closes Monday 17:00 ET
+    ASSERT_TRUE(eth.sessionAt(kMonday - 24 * kHour, open, close));
+    EXPECT_EQ(open, kMonday - kHour);
+    EXPECT_EQ(close, kMonday + 22 * kHour);
+    EXPECT_TRUE(eth.contains(kMonday + 3 * kHour));
+    EXPECT_FALSE(eth.contains(kMonday + 22 * kHour + 30 * kMinute));  // Daily maintenance break
+}
+
+TEST(SessionCalendarTest, HolidaysAndEarlyClosesFromFile) {
+    const char* path = "test_sessions.cal";
+    {
+        std::ofstream out(path);
+        out << "# test calendar\n"
+            << "timezone UTC\n"
+            << "hours 10:00 12:00\n"
+            << "holiday 2024-03-05\n"
+            << "early_close 2024-03-06 11:00   # half day\n";
+    }
+    SessionCalendar calendar = SessionCalendar::fromFile(path);
+    std::remove(path);
+    
+    int64_t open, close;
+    ASSERT_TRUE(calendar.sessionAt(kMonday + 13 * kHour, open, close));  // After Monday's close
+    EXPECT_EQ(open, kMonday + 2 * 24 * kHour + 10 * kHour);              // Tuesday skipped
+    EXPECT_EQ(close, kMonday + 2 * 24 * kHour + 11 * kHour);
+    
+    {
+        std::ofstream out(path);
+        out << "hours 10:00\n";
+    }
+    EXPECT_THROW(SessionCalendar::fromFile(path), std::runtime_error);
+    std::remove(path);
+    EXPECT_THROW(SessionCalendar::fromFile("missing.cal"), std::runtime_error);
+}
+
+TEST(SessionFilterTest, FiltersSeekableAndStreamedSourcesAlike) {
+    // Three days of minute ticks in UTC sessions 10:00-12:00
+    SessionCalendar calendar(10 * 60, 12 * 60, TimeZone::utc());
+    std::vector<Tick> ticks = minuteTicks(kMonday, 3 * 24 * 60);
+    
+    const char* path = "test_sessions.atk";
+    {
+        TickFileWriter writer(path);
+        writer.write(ticks.data(), ticks.size());
+        writer.close();
+    }
+    MarketDataReader reader(path);
+    SessionFilter seeking(reader, calendar);
+    std::vector<Tick> viaSeek = drain(seeking);
+    std::remove(path);
+    
+    PackedTicks packed;
+    packed.append(ticks.data(), ticks.size());
+    PackedTickReader stream(packed);
+    SessionFilter scanning(stream, calendar);
+    std::vector<Tick> viaScan = drain(scanning);
+    
+    ASSERT_EQ(viaSeek.size(), 3u * 120u);
+    ASSERT_EQ(viaScan.size(), viaSeek.size());
+    for (size_t i = 0; i < viaSeek.size(); ++i) {
+        EXPECT_EQ(viaSeek[i].timestamp, viaScan[i].timestamp);
+        EXPECT_TRUE(calendar.contains(viaSeek[i].timestamp));
+    }
+}
+
+TEST(SessionFilterTest, BoundaryResetFlattensEachSession) {
+    // Eight-hour sessions of one tick per second, long enough to warm the
+    // 20000-tick window inside each session
+    SessionCalendar calendar(10 * 60, 18 * 60, TimeZone::utc());
+    PackedTicks packed;
+    for (int day = 0; day < 3; ++day) {
+        int64_t open = kMonday + day * 24 * kHour + 10 * kHour;
+        for (int i = 0; i < 8 * 3600; ++i) {
+            int phase = i % 4000;
+            int offset = phase < 2000 ? phase / 10 : 400 - phase / 10;
+            packed.append(Tick{open + i * 1000000LL, 4500.00 + 0.25 * offset, 4500.25 + 0.25 * offset, 1});
+        }
+    }
+    
+    Backtester carry(0.0, 0.0);
+    carry.setSessions(calendar, SessionBoundary::Carry);
+    PackedTickReader first(packed);
+    PerformanceMetrics carried = carry.run(first, 1.0);
+    EXPECT_EQ(carried.totalTicks, packed.size());
+    EXPECT_GT(carried.totalTrades, 0u);
+    
+    Backtester reset(0.0, 0.0);
+    reset.setSessions(calendar, SessionBoundary::Reset);
+    PackedTickReader second(packed);
+    PerformanceMetrics restarted = reset.run(second, 1.0);
+    EXPECT_EQ(restarted.totalTicks, packed.size());
+    ASSERT_GT(restarted.totalTrades, 0u);
+    
+    // Each session warms up from scratch and no trade spans the closed hours
+    for (const Trade& trade : reset.getTrades()) {
+        int64_t entryDay = (trade.entryTime - kMonday) / (24 * kHour);
+        int64_t exitDay = (trade.exitTime - kMonday) / (24 * kHour);
+        EXPECT_EQ(entryDay, exitDay);
+        int64_t sessionOpen = kMonday + entryDay * 24 * kHour + 10 * kHour;
+        EXPECT_GE(trade.entryTime, sessionOpen + 19999 * 1000000LL);
+    }
+}
+
+TEST(SessionFilterTest, BackwardTimestampsDoNotRewindTheReader) {
+    // One day of minute ticks in a UTC session 10:00-12:00. Three ticks
+    // inside the session jump 10 h back: one mid-view, one at the first
+    // view boundary after the seek to the open (10:00 + 100 ticks).
+    SessionCalendar calendar(10 * 60, 12 * 60, TimeZone::utc());
+    std::vector<Tick> ticks = minuteTicks(kMonday, 24 * 60);
+    for (int minute : {10 * 60 + 50, 11 * 60 + 30, 11 * 60 + 40}) {
+        ticks[minute].timestamp -= 10 * kHour;
+    }
+    
+    const char* path = "test_sessions_backward.atk";
+    {
+        TickFileWriter writer(path);
+        writer.write(ticks.data(), ticks.size());
+        writer.close();
+    }
+    
+    auto boundedDrain = [](TickSource& source) {
+        std::vector<Tick> out;
+        TickView view;
+        while (out.size() < 10000 && !(view = source.nextView(100)).empty()) {
+            out.insert(out.end(), view.begin(), view.end());
+        }
+        return out;
+    };
+    
+    MarketDataReader reader(path);
+    SessionFilter seeking(reader, calendar);
+    std::vector<Tick> viaSeek = boundedDrain(seeking);
+    
+    PackedTicks packed;
+    packed.append(ticks.data(), ticks.size());
+    PackedTickReader stream(packed);
+    SessionFilter scanning(stream, calendar);
+    std::vector<Tick> viaScan = boundedDrain(scanning);
+    
+    ASSERT_EQ(viaSeek.size(), 117u);
+    ASSERT_EQ(viaScan.size(), 117u);
+    for (size_t i = 0; i < viaSeek.size(); ++i) {
+        EXPECT_TRUE(calendar.contains(viaSeek[i].timestamp));
+        EXPECT_EQ(viaSeek[i].timestamp, viaScan[i].timestamp);
+    }
+    
+    Backtester backtester(0.0, 0.0);
+    backtester.setSessions(calendar);
+    EXPECT_EQ(backtester.run(path, 1.0).totalTicks, 117u);
+    std::remove(path);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "StreamReader.hpp"
+#include "MarketDataReader.hpp"
+#include "Backtester.hpp"
+#include "TestUtil.hpp"
+#include <cerrno>
+#include <stdexcept>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+std::vector<Tick> streamTicks(int count) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < count; ++i) {
+        ticks.push_back(Tick{1000000 + i * 1000, 4500.0 + (i % 16) * 0.25, 4500.25 + (i % 16) * 0.25,
+                             100 + i % 50});
+    }
+    return ticks;
+}
+
+std::vector<Tick> readMapped(const std::string& path) {
+    MarketDataReader reader(path);
+    return readAllTicks(reader);
+}
+
+void expectSameTicks(const std::vector<Tick>& a, const std::vector<Tick>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].timestamp, b[i].timestamp) << "tick " << i;
+        ASSERT_DOUBLE_EQ(a[i].bid, b[i].bid) << "tick " << i;
+        ASSERT_DOUBLE_EQ(a[i].ask, b[i].ask) << "tick " << i;
+        ASSERT_EQ(a[i].volume, b[i].volume) << "tick " << i;
+    }
+}
+
+class StreamReaderTest : public TempDirTest {};
+
+}  // namespace
+
+TEST_F(StreamReaderTest, MatchesMappedReader) {
+    std::string testFile = path("ticks.csv");
+    writeCsv(testFile, streamTicks(5000));
+    std::vector<Tick> expected = readMapped(testFile);
+    
+    // Buffer sizes that split lines at many different offsets
+    for (size_t bufferSize : {size_t(64), size_t(97), size_t(1000), size_t(4096), size_t(1) << 20}) {
+        StreamReader reader(testFile, bufferSize);
+        ASSERT_TRUE(reader.isValid());
+        
+        std::vector<Tick> ticks;
+        Tick tick;
+        while (reader.next(tick)) {
+            ticks.push_back(tick);
+        }
+        expectSameTicks(ticks, expected);
+    }
+}
+
+TEST_F(StreamReaderTest, NextBatch) {
+    std::string testFile = path("ticks.csv");
+    writeCsv(testFile, streamTicks(3001));
+    std::vector<Tick> expected = readMapped(testFile);
+    
+    StreamReader reader(testFile, 333);
+    expectSameTicks(readAllTicks(reader, 256), expected);
+    Tick batch[256];
+    ASSERT_EQ(reader.nextBatch(batch, 256), 0u);
+}
+
+TEST_F(StreamReaderTest, MalformedAndLongLines) {
+    std::string testFile = path("malformed.csv");
+    {
+        std::ofstream out(testFile);
+        out << "timestamp,bid,ask,volume\n";
+        out << "1000000,4500.25,4500.50,100\n";
+        out << std::string(StreamReader::kMaxLineLength * 3, 'x') << "\n";
+        out << "invalid_line\n";
+        out << "2000000,4500.75,4501.00,200\r\n";
+        out << "3000000,4501.25,4501.50,150";  // No trailing newline
+    }
+    
+    StreamReader reader(testFile, 256);
+    Tick tick;
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, 1000000);
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, 2000000);
+    ASSERT_EQ(tick.volume, 200);
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, 3000000);
+    ASSERT_FALSE(reader.next(tick));
+}
+
+#ifndef _WIN32
+TEST_F(StreamReaderTest, Fifo) {
+    std::string csvFile = path("ticks.csv");
+    std::string fifo = path("ticks.fifo");
+    writeCsv(csvFile, streamTicks(2000));
+    std::vector<Tick> expected = readMapped(csvFile);
+    
+    ASSERT_EQ(mkfifo(fifo.c_str(), 0600), 0);
+    ASSERT_TRUE(isStreamPath(fifo));
+    ASSERT_TRUE(isStreamPath("-"));
+    ASSERT_FALSE(isStreamPath(csvFile));
+    
+    // Writer dribbles the file into the pipe in small pieces
+    std::thread writer([&]() {
+        std::ifstream in(csvFile, std::ios::binary);
+        std::ofstream out(fifo, std::ios::binary);
+        char chunk[173];
+        while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0) {
+            out.write(chunk, in.gcount());
+            out.flush();
+        }
+    });
+    
+    std::unique_ptr<TickSource> source = openTickSource(fifo);
+    ASSERT_TRUE(source->isValid());
+    ASSERT_EQ(source->tickCount(), 0u);
+    
+    std::vector<Tick> ticks = readAllTicks(*source);
+    writer.join();
+    expectSameTicks(ticks, expected);
+}
+#endif
+
+TEST_F(StreamReaderTest, MissingFile) {
+    StreamReader reader("does_not_exist.csv");
+    ASSERT_FALSE(reader.isValid());
+    Tick tick;
+    ASSERT_FALSE(reader.next(tick));
+}
+
+#ifndef _WIN32
+TEST_F(StreamReaderTest, ReadErrorIsNotEof) {
+    // A directory opens fine but every read() fails with EISDIR
+    std::string directory = path("subdir");
+    ::mkdir(directory.c_str(), 0755);
+    {
+        StreamReader reader(directory);
+        ASSERT_TRUE(reader.isValid());
+        Tick tick;
+        EXPECT_FALSE(reader.next(tick));
+        EXPECT_EQ(reader.error(), EISDIR);
+        EXPECT_THROW(throwIfReadFailed(reader, directory), std::runtime_error);
+    }
+    {
+        StreamReader reader(directory);
+        Backtester backtester;
+        EXPECT_THROW(backtester.run(reader), std::runtime_error);
+    }
+    
+    // A clean end of input reports no error
+    writeCsv(path("ok.csv"), streamTicks(10));
+    StreamReader reader(path("ok.csv"));
+    Tick tick;
+    while (reader.next(tick)) {
+    }
+    EXPECT_EQ(reader.error(), 0);
+}
+#endif
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "TickCache.hpp"
+#include "MarketDataReader.hpp"
+#include "TestUtil.hpp"
+#include "TickFile.hpp"
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<Tick> cacheTicks(int count, double bid) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < count; ++i) {
+        ticks.push_back(Tick{1700000000000000LL + i * 1000, bid, 4500.75, i + 1});
+    }
+    return ticks;
+}
+
+std::vector<Tick> readFile(const std::string& path) {
+    MarketDataReader reader(path);
+    return reader.readAll(1);
+}
+
+class TickCacheTest : public TempDirTest {
+protected:
+    void SetUp() override {
+        TempDirTest::SetUp();
+        cacheDir_ = path("cache");
+        fs::create_directory(cacheDir_);
+        csv_ = path("ticks.csv");
+    }
+    
+    size_t entryCount() const {
+        return static_cast<size_t>(std::distance(fs::directory_iterator(cacheDir_), fs::directory_iterator()));
+    }
+    
+    std::string cacheDir_;
+    std::string csv_;
+};
+
+}  // namespace
+
+TEST_F(TickCacheTest, BuildsOnceAndReusesEntry) {
+    writeCsv(csv_, cacheTicks(1000, 4500.25));
+    TickCache cache(cacheDir_);
+    ASSERT_TRUE(cache.isAvailable());
+    
+    std::string entry = cache.attach(csv_);
+    EXPECT_NE(entry, csv_);
+    EXPECT_EQ(fs::path(entry).filename().string(), cache.entryName(csv_));
+    
+    MarketDataReader cached(entry);
+    EXPECT_EQ(cached.format(), MarketDataReader::Format::Binary);
+    EXPECT_TRUE(cached.verifyChecksum());
+    
+    std::vector<Tick> expected = readFile(csv_);
+    std::vector<Tick> actual = readFile(entry);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].timestamp, expected[i].timestamp);
+        EXPECT_EQ(actual[i].bid, expected[i].bid);
+        EXPECT_EQ(actual[i].volume, expected[i].volume);
+    }
+    
+    // Second attach maps the existing entry instead of rewriting it
+    auto written = fs::last_write_time(entry);
+    EXPECT_EQ(cache.attach(csv_), entry);
+    EXPECT_EQ(fs::last_write_time(entry), written);
+    EXPECT_EQ(entryCount(), 1u);
+}
+
+TEST_F(TickCacheTest, ChangedSourceReplacesStaleEntry) {
+    writeCsv(csv_, cacheTicks(1000, 4500.25));
+    TickCache cache(cacheDir_);
+    std::string first = cache.attach(csv_);
+    
+    // Same size, different content
+    writeCsv(csv_, cacheTicks(1000, 4500.50));
+    std::string second = cache.attach(csv_);
+    EXPECT_NE(second, first);
+    EXPECT_FALSE(fs::exists(first));
+    EXPECT_EQ(entryCount(), 1u);
+    EXPECT_EQ(readFile(second)[0].bid, 4500.50);
+}
+
+TEST_F(TickCacheTest, PassesThroughNonCsvInputs) {
+    TickCache cache(cacheDir_);
+    EXPECT_EQ(cache.attach("does_not_exist.csv"), "does_not_exist.csv");
+    EXPECT_EQ(cache.attach("-"), "-");
+    EXPECT_EQ(cache.attach(cacheDir_), cacheDir_);
+    EXPECT_EQ(cache.attach("data.atk"), "data.atk");
+    EXPECT_EQ(entryCount(), 0u);
+}
+
+TEST_F(TickCacheTest, EntryHeaderTakesCallerInstrument) {
+    writeCsv(csv_, cacheTicks(5000, 4500.25));
+    TickCache cache(cacheDir_);
+    std::string entry = cache.attach(csv_, "NQ", 0.25);
+    ASSERT_NE(entry, csv_);
+    
+    TickFileHeader header;
+    std::ifstream in(entry, std::ios::binary);
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    EXPECT_STREQ(header.instrument, "NQ");
+    EXPECT_EQ(header.recordCount, 5000u);
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "TickFile.hpp"
+#include "MarketDataReader.hpp"
+#include <fstream>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+std::vector<Tick> makeTicks(size_t count) {
+    std::vector<Tick> ticks;
+    for (size_t i = 0; i < count; ++i) {
+        ticks.push_back({static_cast<int64_t>(1000000 + i * 1000),
+                         4500.25 + 0.25 * (i % 8), 4500.50 + 0.25 * (i % 8),
+                         static_cast<int64_t>(100 + i)});
+    }
+    return ticks;
+}
+
+}  // namespace
+
+TEST(TickFileTest, RoundTrip) {
+    std::string testFile = "test_ticks.atk";
+    std::vector<Tick> ticks = makeTicks(1000);
+    {
+        TickFileWriter writer(testFile, "ES", 0.25);
+        ASSERT_TRUE(writer.isValid());
+        writer.write(ticks.data(), 600);
+        for (size_t i = 600; i < ticks.size(); ++i) {
+            writer.write(ticks[i]);
+        }
+        ASSERT_EQ(writer.recordCount(), 1000u);
+        ASSERT_TRUE(writer.close());
+    }
+    
+    MarketDataReader reader(testFile);
+    ASSERT_TRUE(reader.isValid());
+    ASSERT_EQ(reader.format(), MarketDataReader::Format::Binary);
+    ASSERT_TRUE(reader.verifyChecksum());
+    ASSERT_EQ(reader.approximateTickCount(), 1000u);
+    
+    Tick tick;
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, ticks[0].timestamp);
+    
+    std::vector<Tick> batch(512);
+    size_t total = 1;
+    size_t n;
+    while ((n = reader.nextBatch(batch.data(), batch.size())) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(batch[i].timestamp, ticks[total + i].timestamp);
+            ASSERT_EQ(batch[i].bid, ticks[total + i].bid);
+            ASSERT_EQ(batch[i].ask, ticks[total + i].ask);
+            ASSERT_EQ(batch[i].volume, ticks[total + i].volume);
+        }
+        total += n;
+    }
+    ASSERT_EQ(total, 1000u);
+    ASSERT_FALSE(reader.next(tick));
+    
+    reader.reset();
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, ticks[0].timestamp);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickFileTest, ChecksumDetectsCorruption) {
+    std::string testFile = "test_ticks_corrupt.atk";
+    std::vector<Tick> ticks = makeTicks(10);
+    {
+        TickFileWriter writer(testFile);
+        writer.write(ticks.data(), ticks.size());
+    }  // Destructor finalizes the header
+    
+    {
+        std::fstream f(testFile, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(sizeof(TickFileHeader) + 5 * sizeof(Tick) + 8);
+        double bad = 1.0;
+        f.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+    }
+    
+    MarketDataReader reader(testFile);
+    ASSERT_EQ(reader.format(), MarketDataReader::Format::Binary);
+    ASSERT_FALSE(reader.verifyChecksum());
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickFileTest, TruncatedFileRejected) {
+    std::string testFile = "test_ticks_truncated.atk";
+    std::vector<Tick> ticks = makeTicks(10);
+    {
+        TickFileWriter writer(testFile);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    std::vector<char> bytes(sizeof(TickFileHeader) + 3 * sizeof(Tick));
+    {
+        std::ifstream in(testFile, std::ios::binary);
+        in.read(bytes.data(), bytes.size());
+    }
+    {
+        std::ofstream out(testFile, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size());
+    }
+    
+    ASSERT_FALSE(isTickFile(bytes.data(), bytes.size()));
+    MarketDataReader reader(testFile);
+    ASSERT_FALSE(reader.isValid());
+    Tick tick;
+    ASSERT_FALSE(reader.next(tick));
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickFileTest, CsvIsNotTickFile) {
+    const char csv[] = "timestamp,bid,ask,volume\n1000000,4500.25,4500.50,100\n"
+                       "2000000,4500.75,4501.00,200\n";
+    ASSERT_FALSE(isTickFile(csv, sizeof(csv) - 1));
+}
+
+TEST(TickFileTest, SeekAndRange) {
+    std::string testFile = "test_ticks_seek.atk";
+    std::vector<Tick> ticks = makeTicks(1000);  // 1000us spacing from 1000000
+    {
+        TickFileWriter writer(testFile);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    MarketDataReader reader(testFile);
+    Tick tick;
+    ASSERT_TRUE(reader.seek(1500500));
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, 1501000);
+    ASSERT_FALSE(reader.seek(2000000));
+    
+    MarketDataReader range(testFile, 1100000, 1200000);
+    std::vector<Tick> all = range.readAll();
+    ASSERT_EQ(all.size(), 100u);
+    ASSERT_EQ(all.front().timestamp, 1100000);
+    ASSERT_EQ(all.back().timestamp, 1199000);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickFileTest, ViewPointsIntoMapping) {
+    std::string testFile = "test_ticks_view.atk";
+    std::vector<Tick> ticks = makeTicks(1000);
+    {
+        TickFileWriter writer(testFile);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    MarketDataReader reader(testFile);
+    TickView first = reader.nextView(300);
+    ASSERT_EQ(first.size(), 300u);
+    TickView second = reader.nextView(300);
+    ASSERT_EQ(second.begin(), first.end());  // Consecutive records of the same mapping
+    
+    size_t total = first.size() + second.size();
+    TickView view;
+    while (!(view = reader.nextView(300)).empty()) {
+        ASSERT_EQ(view[0].timestamp, ticks[total].timestamp);
+        total += view.size();
+    }
+    ASSERT_EQ(total, 1000u);
+    ASSERT_EQ(first[299].volume, ticks[299].volume);
+    
+    // Range end clips the view
+    MarketDataReader range(testFile, 1100000, 1200000);
+    view = range.nextView(1000);
+    ASSERT_EQ(view.size(), 100u);
+    ASSERT_EQ(view.back().timestamp, 1199000);
+    ASSERT_TRUE(range.nextView(1000).empty());
+    
+    remove(testFile.c_str());
+}
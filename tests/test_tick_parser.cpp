@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "TickParser.hpp"
+#include "Price.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool parse(const std::string& text, Tick& tick) {
+    bool ok = false;
+    TickParser::parseNext(text.data(), text.data() + text.size(), tick, ok);
+    return ok;
+}
+
+}  // namespace
+
+TEST(TickParserTest, BasicLine) {
+    Tick tick;
+    ASSERT_TRUE(parse("1609459200001825,4499.50,4500.25,12\n", tick));
+    ASSERT_EQ(tick.timestamp, 1609459200001825LL);
+    ASSERT_EQ(tick.bid, 4499.50);
+    ASSERT_EQ(tick.ask, 4500.25);
+    ASSERT_EQ(tick.volume, 12);
+}
+
+TEST(TickParserTest, QuarterTickPricesAreExact) {
+    const char* fractions[] = {"00", "25", "5", "75"};
+    const double expected[] = {4500.0, 4500.25, 4500.5, 4500.75};
+    for (int i = 0; i < 4; ++i) {
+        Tick tick;
+        std::string line = std::string("1,4500.") + fractions[i] + ",4501,1\n";
+        ASSERT_TRUE(parse(line, tick));
+        ASSERT_EQ(tick.bid, expected[i]);  // bitwise exact, not approximately equal
+        ASSERT_EQ(tick.ask, 4501.0);
+    }
+}
+
+TEST(TickParserTest, LongLineUsesScalarPath) {
+    // Fields padded past the 64-byte SIMD window
+    std::string line = "1000000,0000000000004500.25,0000000000004500.50,00000000000000100\n";
+    ASSERT_GT(line.size(), 64u);
+    Tick tick;
+    ASSERT_TRUE(parse(line, tick));
+    ASSERT_EQ(tick.bid, 4500.25);
+    ASSERT_EQ(tick.ask, 4500.50);
+    ASSERT_EQ(tick.volume, 100);
+}
+
+TEST(TickParserTest, SimdAndScalarPathsAgree) {
+    // Same line, once with enough trailing bytes for the 64-byte path
+    // and once at the very end of the buffer
+    std::string line = "2000000,4500.75,4501.00,200\r\n";
+    std::string padded = line + std::string(64, 'x');
+    Tick a, b;
+    ASSERT_TRUE(parse(padded, a));
+    ASSERT_TRUE(parse(line, b));
+    ASSERT_EQ(a.timestamp, b.timestamp);
+    ASSERT_EQ(a.bid, b.bid);
+    ASSERT_EQ(a.ask, b.ask);
+    ASSERT_EQ(a.volume, b.volume);
+    ASSERT_EQ(a.volume, 200);
+}
+
+TEST(TickParserTest, ExtraColumnsIgnored) {
+    Tick tick;
+    ASSERT_TRUE(parse("3000000,4501.25,4501.50,150,ESH1\n", tick));
+    ASSERT_EQ(tick.volume, 150);
+}
+
+TEST(TickParserTest, MalformedLinesRejected) {
+    Tick tick;
+    ASSERT_FALSE(parse("invalid_line\n", tick));
+    ASSERT_FALSE(parse("another,bad,line\n", tick));
+    ASSERT_FALSE(parse("1000000,45x0.25,4500.50,100\n", tick));
+    ASSERT_FALSE(parse("1000000,4500.25,4500.50,\n", tick));
+    ASSERT_FALSE(parse("1000000,4500.2.5,4500.50,100\n", tick));
+    ASSERT_FALSE(parse("\n", tick));
+    ASSERT_FALSE(parse("timestamp,bid,ask,volume\n", tick));
+}
+
+TEST(TickParserTest, ReturnsNextLine) {
+    std::string text = "1,1.00,2.00,3\n4,5.00,6.00,7";
+    const char* end = text.data() + text.size();
+    Tick tick;
+    bool ok = false;
+    const char* p = TickParser::parseNext(text.data(), end, tick, ok);
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(p, text.data() + 14);
+    p = TickParser::parseNext(p, end, tick, ok);
+    ASSERT_TRUE(ok);  // Last line without newline
+    ASSERT_EQ(tick.timestamp, 4);
+    ASSERT_EQ(p, end);
+}
+
+TEST(TickParserTest, PriceScaleRoundTrip) {
+    PriceScale es(0.25);
+    for (PriceTicks t = 17990; t < 18010; ++t) {
+        double price = es.toPrice(t);
+        ASSERT_EQ(es.toTicks(price), t);
+        ASSERT_TRUE(es.onGrid(price));
+        
+        // Same double as the text parser produces
+        std::string text = std::to_string(price);
+        double parsed;
+        ASSERT_TRUE(TickParser::parsePrice(text.data(), text.data() + text.size(), parsed));
+        ASSERT_EQ(parsed, price);
+    }
+    ASSERT_FALSE(es.onGrid(4500.1));
+    
+    PriceScale halfTicks(0.125);
+    ASSERT_EQ(halfTicks.toTicks((4500.25 + 4500.50) / 2), 36003);
+}
+
+TEST(TickParserTest, PriceScaleRejectsBadTickSize) {
+    EXPECT_THROW(PriceScale(0.0), std::invalid_argument);
+    EXPECT_THROW(PriceScale(-0.25), std::invalid_argument);
+    EXPECT_THROW(PriceScale(std::nan("")), std::invalid_argument);
+    EXPECT_THROW(PriceScale(std::numeric_limits<double>::infinity()), std::invalid_argument);
+    EXPECT_NO_THROW(PriceScale(0.01));
+}
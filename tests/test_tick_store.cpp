@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include "TickStore.hpp"
+#include "MarketDataReader.hpp"
+#include "Backtester.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<Tick> makeTicks(size_t count) {
+    std::vector<Tick> ticks;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> gap(1, 20000);
+    std::uniform_int_distribution<int> move(-2, 2);
+    std::uniform_int_distribution<int> spread(0, 2);
+    std::uniform_int_distribution<int> vol(1, 500);
+    
+    int64_t ts = 1609459200000000LL;
+    int64_t bidTicks = 18000;  // 4500.00
+    for (size_t i = 0; i < count; ++i) {
+        ts += gap(gen);
+        bidTicks += move(gen);
+        Tick t;
+        t.timestamp = ts;
+        t.bid = bidTicks * 0.25;
+        t.ask = (bidTicks + spread(gen)) * 0.25;
+        t.volume = vol(gen);
+        ticks.push_back(t);
+    }
+    return ticks;
+}
+
+}  // namespace
+
+TEST(TickStoreTest, RoundTripAcrossBlocks) {
+    std::string testFile = "test_ticks.atc";
+    std::vector<Tick> ticks = makeTicks(10000);
+    {
+        ColumnarTickWriter writer(testFile, "ES", 0.25, 1024);
+        ASSERT_TRUE(writer.isValid());
+        writer.write(ticks.data(), ticks.size());
+        ASSERT_EQ(writer.tickCount(), ticks.size());
+        ASSERT_TRUE(writer.close());
+    }
+    
+    MarketDataReader reader(testFile);
+    ASSERT_TRUE(reader.isValid());
+    ASSERT_EQ(reader.format(), MarketDataReader::Format::Columnar);
+    ASSERT_EQ(reader.approximateTickCount(), ticks.size());
+    
+    // Mix single-tick and odd-sized batch reads across block boundaries
+    Tick tick;
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, ticks[0].timestamp);
+    
+    std::vector<Tick> batch(777);
+    size_t total = 1;
+    size_t n;
+    while ((n = reader.nextBatch(batch.data(), batch.size())) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            const Tick& expected = ticks[total + i];
+            ASSERT_EQ(batch[i].timestamp, expected.timestamp);
+            ASSERT_EQ(batch[i].bid, expected.bid);
+            ASSERT_EQ(batch[i].ask, expected.ask);
+            ASSERT_EQ(batch[i].volume, expected.volume);
+        }
+        total += n;
+    }
+    ASSERT_EQ(total, ticks.size());
+    ASSERT_FALSE(reader.next(tick));
+    
+    reader.reset();
+    ASSERT_TRUE(reader.next(tick));
+    ASSERT_EQ(tick.timestamp, ticks[0].timestamp);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, CompressesBelowRawSize) {
+    std::string testFile = "test_ticks_size.atc";
+    std::vector<Tick> ticks = makeTicks(20000);
+    {
+        ColumnarTickWriter writer(testFile);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    std::ifstream in(testFile, std::ios::binary | std::ios::ate);
+    size_t bytes = static_cast<size_t>(in.tellg());
+    ASSERT_LT(bytes, ticks.size() * sizeof(Tick) / 4);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, OffGridPriceRejected) {
+    std::string testFile = "test_ticks_offgrid.atc";
+    ColumnarTickWriter writer(testFile, "ES", 0.25);
+    Tick bad{1000000, 4500.10, 4500.25, 1};
+    EXPECT_THROW(writer.write(bad), std::invalid_argument);
+    writer.close();
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, CorruptBlockDetected) {
+    std::vector<Tick> ticks = makeTicks(16);
+    std::string testFile = "test_ticks_corrupt.atc";
+    {
+        ColumnarTickWriter writer(testFile, "ES", 0.25);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    std::ifstream in(testFile, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_TRUE(isColumnStore(bytes.data(), bytes.size()));
+    
+    ColumnStoreHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    ColumnBlockIndex entry;
+    std::memcpy(&entry, bytes.data() + header.indexOffset, sizeof(entry));
+    
+    std::vector<Tick> out(entry.count);
+    const char* block = bytes.data() + entry.offset;
+    ASSERT_EQ(decodeColumnBlock(block, entry.bytes, 0.25, out.data(), out.size()), 16u);
+    ASSERT_EQ(entry.minTimestamp, ticks.front().timestamp);
+    ASSERT_EQ(entry.maxTimestamp, ticks.back().timestamp);
+    
+    // Truncated block and undersized output are both rejected
+    ASSERT_EQ(decodeColumnBlock(block, entry.bytes - 4, 0.25, out.data(), out.size()), 0u);
+    ASSERT_EQ(decodeColumnBlock(block, entry.bytes, 0.25, out.data(), 8), 0u);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, SeekUsesBlockIndex) {
+    std::string testFile = "test_ticks_seek.atc";
+    std::vector<Tick> ticks = makeTicks(5000);
+    {
+        ColumnarTickWriter writer(testFile, "ES", 0.25, 256);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    MarketDataReader reader(testFile);
+    for (size_t i : {0u, 1u, 255u, 256u, 257u, 3333u, 4999u}) {
+        Tick tick;
+        ASSERT_TRUE(reader.seek(ticks[i].timestamp));
+        ASSERT_TRUE(reader.next(tick));
+        ASSERT_EQ(tick.timestamp, ticks[i].timestamp);
+        ASSERT_EQ(tick.volume, ticks[i].volume);
+    }
+    ASSERT_FALSE(reader.seek(ticks.back().timestamp + 1));
+    
+    MarketDataReader range(testFile, ticks[1000].timestamp, ticks[2000].timestamp);
+    std::vector<Tick> batch(300);
+    size_t total = 0;
+    size_t n;
+    while ((n = range.nextBatch(batch.data(), batch.size())) > 0) {
+        ASSERT_EQ(batch[0].timestamp, ticks[1000 + total].timestamp);
+        total += n;
+    }
+    ASSERT_EQ(total, 1000u);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, ViewOverDecodedBlocks) {
+    std::string testFile = "test_ticks_view.atc";
+    std::vector<Tick> ticks = makeTicks(1000);
+    {
+        ColumnarTickWriter writer(testFile, "ES", 0.25, 256);
+        writer.write(ticks.data(), ticks.size());
+    }
+    
+    // Views never span blocks, and the last one is clipped by the range end
+    MarketDataReader reader(testFile, ticks[0].timestamp, ticks[900].timestamp);
+    size_t total = 0;
+    TickView view;
+    while (!(view = reader.nextView(200)).empty()) {
+        ASSERT_LE(view.size(), 200u);
+        for (const Tick& tick : view) {
+            ASSERT_EQ(tick.timestamp, ticks[total].timestamp);
+            ASSERT_DOUBLE_EQ(tick.bid, ticks[total].bid);
+            total++;
+        }
+    }
+    ASSERT_EQ(total, 900u);
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, CorruptIndexRejectedAtOpen) {
+    std::string testFile = "test_ticks_index.atc";
+    std::vector<Tick> ticks = makeTicks(3000);
+    {
+        ColumnarTickWriter writer(testFile, "ES", 0.25, 1024);
+        writer.write(ticks.data(), ticks.size());
+        ASSERT_TRUE(writer.close());
+    }
+    ColumnStoreHeader header;
+    {
+        std::ifstream in(testFile, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+    
+    // Patch one field of the second index entry and reopen
+    auto patchEntry = [&](size_t field, const void* value, size_t size) {
+        std::fstream io(testFile, std::ios::binary | std::ios::in | std::ios::out);
+        io.seekp(static_cast<std::streamoff>(header.indexOffset + sizeof(ColumnBlockIndex) + field));
+        io.write(static_cast<const char*>(value), static_cast<std::streamsize>(size));
+    };
+    
+    uint32_t hugeCount = 0xFFFFFFFFu;
+    patchEntry(offsetof(ColumnBlockIndex, count), &hugeCount, sizeof(hugeCount));
+    EXPECT_FALSE(MarketDataReader(testFile).isValid());
+    
+    uint32_t goodCount = 1024;
+    patchEntry(offsetof(ColumnBlockIndex, count), &goodCount, sizeof(goodCount));
+    ASSERT_TRUE(MarketDataReader(testFile).isValid());
+    
+    uint64_t pastIndex = header.indexOffset;
+    patchEntry(offsetof(ColumnBlockIndex, offset), &pastIndex, sizeof(pastIndex));
+    EXPECT_FALSE(MarketDataReader(testFile).isValid());
+    
+    remove(testFile.c_str());
+}
+
+TEST(TickStoreTest, CorruptBlockEndsReplayWithError) {
+    std::string testFile = "test_ticks_bad_block.atc";
+    std::vector<Tick> ticks = makeTicks(3000);
+    {
+        ColumnarTickWriter writer(testFile, "ES", 0.25, 1024);
+        writer.write(ticks.data(), ticks.size());
+        ASSERT_TRUE(writer.close());
+    }
+    
+    // Turn the second block's volume column into one unterminated varint.
+    // The index still checks out, so the file opens.
+    {
+        std::fstream io(testFile, std::ios::binary | std::ios::in | std::ios::out);
+        ColumnStoreHeader header;
+        io.read(reinterpret_cast<char*>(&header), sizeof(header));
+        ColumnBlockIndex entry;
+        io.seekg(static_cast<std::streamoff>(header.indexOffset + sizeof(ColumnBlockIndex)));
+        io.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+        ColumnBlockHeader block;
+        io.seekg(static_cast<std::streamoff>(entry.offset));
+        io.read(reinterpret_cast<char*>(&block), sizeof(block));
+        size_t volumeStart = sizeof(block) + block.volumeOffset;
+        std::string junk(entry.bytes - volumeStart, '\x80');
+        io.seekp(static_cast<std::streamoff>(entry.offset + volumeStart));
+        io.write(junk.data(), static_cast<std::streamsize>(junk.size()));
+    }
+    
+    MarketDataReader reader(testFile);
+    ASSERT_TRUE(reader.isValid());
+    std::vector<Tick> batch(4096);
+    size_t total = 0;
+    size_t n;
+    while ((n = reader.nextBatch(batch.data(), batch.size())) > 0) {
+        total += n;
+    }
+    EXPECT_EQ(total, 1024u);  // Stops at the bad block instead of skipping it
+    EXPECT_EQ(reader.error(), EBADMSG);
+    EXPECT_THROW(throwIfReadFailed(reader, testFile), std::runtime_error);
+    
+    reader.reset();
+    EXPECT_EQ(reader.error(), 0);
+    
+    Backtester backtester;
+    EXPECT_THROW(backtester.run(testFile, 2.5), std::runtime_error);
+    
+    remove(testFile.c_str());
+}
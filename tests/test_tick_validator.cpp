@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "TickValidator.hpp"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Clean, strictly increasing quotes one second apart
+std::vector<Tick> cleanTicks(size_t count) {
+    std::vector<Tick> ticks;
+    for (size_t i = 0; i < count; ++i) {
+        double bid = 4500.0 + 0.25 * static_cast<double>(i % 8);
+        ticks.push_back(Tick{1000000 * static_cast<int64_t>(i + 1), bid, bid + 0.25, 1});
+    }
+    return ticks;
+}
+
+}  // namespace
+
+TEST(TickValidatorTest, CleanViewsAreNotCopied) {
+    std::vector<Tick> ticks = cleanTicks(1000);
+    TickValidator validator;
+    TickView view{ticks.data(), ticks.data() + ticks.size()};
+    TickView result = validator.apply(view);
+    
+    EXPECT_EQ(result.begin(), view.begin());
+    EXPECT_EQ(result.size(), view.size());
+    EXPECT_EQ(validator.stats().ticks, 1000u);
+    EXPECT_EQ(validator.stats().dropped, 0u);
+}
+
+TEST(TickValidatorTest, CountsMatchScalarDefinitions) {
+    // Issues at every lane offset so both the SIMD and tail paths see them
+    std::vector<Tick> ticks = cleanTicks(103);
+    ticks[1].bid = ticks[1].ask + 0.25;            // crossed
+    ticks[6].ask = ticks[6].bid;                   // locked
+    ticks[11].bid = 0.0;                           // bad price
+    ticks[16].ask = std::nan("");                  // bad price
+    ticks[21].volume = -5;                         // bad price
+    ticks[27].ask = std::numeric_limits<double>::infinity();
+    ticks[40].timestamp = ticks[39].timestamp - 1;  // out of order
+    ticks[102].bid = ticks[102].ask + 1.0;         // crossed, in the scalar tail
+    
+    ValidationOptions flagAll;
+    flagAll.crossed = TickAction::Flag;
+    flagAll.badPrice = TickAction::Flag;
+    flagAll.outOfOrder = TickAction::Flag;
+    flagAll.maxGap = 1000000;
+    ticks[70].timestamp += 500000;  // 1.5 s gap before 70
+    
+    TickValidator validator(flagAll);
+    EXPECT_EQ(validator.apply(ticks.data(), ticks.size()), ticks.size());
+    const ValidationStats& s = validator.stats();
+    EXPECT_EQ(s.crossed, 2u);
+    EXPECT_EQ(s.locked, 1u);
+    EXPECT_EQ(s.badPrice, 4u);
+    EXPECT_EQ(s.outOfOrder, 1u);
+    EXPECT_EQ(s.gaps, 2u);  // 40 -> 41 and 69 -> 70
+    EXPECT_EQ(s.dropped, 0u);
+}
+
+TEST(TickValidatorTest, DropsByDefault) {
+    std::vector<Tick> ticks = cleanTicks(50);
+    ticks[10].bid = ticks[10].ask + 0.25;
+    ticks[20].bid = -1.0;
+    ticks[30].timestamp = 0;
+    ticks[40].ask = ticks[40].bid;  // Locked: flagged only
+    
+    TickValidator validator;
+    TickView result = validator.apply(TickView{ticks.data(), ticks.data() + ticks.size()});
+    ASSERT_EQ(result.size(), 47u);
+    EXPECT_EQ(validator.stats().dropped, 3u);
+    EXPECT_EQ(validator.stats().locked, 1u);
+    for (size_t i = 1; i < result.size(); ++i) {
+        EXPECT_LT(result[i - 1].timestamp, result[i].timestamp);
+        EXPECT_LE(result[i].bid, result[i].ask);
+        EXPECT_GT(result[i].bid, 0.0);
+    }
+}
+
+TEST(TickValidatorTest, RepairsInPlace) {
+    ValidationOptions repair;
+    repair.crossed = TickAction::Repair;
+    repair.badPrice = TickAction::Repair;
+    repair.outOfOrder = TickAction::Repair;
+    
+    std::vector<Tick> ticks = cleanTicks(10);
+    ticks[0].bid = 0.0;                           // Nothing to carry forward: dropped
+    ticks[3] = Tick{ticks[3].timestamp, 4501.00, 4500.50, 1};
+    ticks[5].bid = std::nan("");
+    ticks[5].volume = -3;
+    ticks[7].timestamp = 5;
+    
+    TickValidator validator(repair);
+    size_t n = validator.apply(ticks.data(), ticks.size());
+    ASSERT_EQ(n, 9u);
+    EXPECT_EQ(validator.stats().dropped, 1u);
+    EXPECT_EQ(validator.stats().repaired, 3u);
+    
+    // Shifted down by one after the dropped first tick
+    EXPECT_EQ(ticks[2].bid, 4500.50);
+    EXPECT_EQ(ticks[2].ask, 4501.00);
+    EXPECT_EQ(ticks[4].bid, ticks[3].bid);
+    EXPECT_EQ(ticks[4].ask, ticks[3].ask);
+    EXPECT_EQ(ticks[4].volume, 0);
+    EXPECT_EQ(ticks[6].timestamp, ticks[5].timestamp);
+}
+
+TEST(TickValidatorTest, OrderIsTrackedAcrossBatches) {
+    std::vector<Tick> first = cleanTicks(8);
+    std::vector<Tick> second = cleanTicks(8);  // Restarts at t = 1 s
+    
+    TickValidator validator;
+    EXPECT_EQ(validator.apply(first.data(), first.size()), 8u);
+    std::vector<Tick> late = second;
+    EXPECT_EQ(validator.apply(late.data(), late.size()), 1u);  // Only t = 8 s is not behind
+    EXPECT_EQ(validator.stats().outOfOrder, 7u);
+    
+    validator.reset();
+    EXPECT_EQ(validator.apply(second.data(), second.size()), 8u);
+    EXPECT_EQ(validator.stats().ticks, 8u);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "UringReader.hpp"
+#include "MarketDataReader.hpp"
+#include "TickFile.hpp"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace {
+
+void writeTestCsv(const std::string& path, int ticks) {
+    std::ofstream out(path);
+    out << "timestamp,bid,ask,volume\n";
+    for (int i = 0; i < ticks; ++i) {
+        out << (1000000 + i * 1000) << "," << (4500.0 + (i % 16) * 0.25) << ","
+            << (4500.25 + (i % 16) * 0.25) << "," << (100 + i % 50) << "\n";
+    }
+}
+
+std::vector<Tick> readAllTicks(TickSource& source) {
+    std::vector<Tick> ticks;
+    Tick batch[256];
+    size_t n;
+    while ((n = source.nextBatch(batch, 256)) > 0) {
+        ticks.insert(ticks.end(), batch, batch + n);
+    }
+    return ticks;
+}
+
+}  // namespace
+
+TEST(UringReaderTest, MatchesMappedReader) {
+    std::string testFile = "test_uring.csv";
+    writeTestCsv(testFile, 20000);  // ~700 KB
+    
+    MarketDataReader mapped(testFile);
+    std::vector<Tick> expected = readAllTicks(mapped);
+    ASSERT_EQ(expected.size(), 20000u);
+    
+    struct Case { unsigned depth; size_t chunk; bool direct; };
+    for (const Case& c : {Case{1, 4096, false}, Case{4, 4096, false}, Case{8, 64 << 10, false},
+                          Case{3, 1 << 20, false}, Case{4, 8192, true}}) {
+        UringOptions options;
+        options.queueDepth = c.depth;
+        options.chunkSize = c.chunk;
+        options.direct = c.direct;
+        UringReader reader(testFile, options);
+        ASSERT_TRUE(reader.isValid());
+        
+        std::vector<Tick> ticks = readAllTicks(reader);
+        ASSERT_EQ(ticks.size(), expected.size()) << "depth " << c.depth << " chunk " << c.chunk;
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            ASSERT_EQ(ticks[i].timestamp, expected[i].timestamp) << "tick " << i;
+            ASSERT_DOUBLE_EQ(ticks[i].bid, expected[i].bid) << "tick " << i;
+            ASSERT_DOUBLE_EQ(ticks[i].ask, expected[i].ask) << "tick " << i;
+            ASSERT_EQ(ticks[i].volume, expected[i].volume) << "tick " << i;
+        }
+    }
+    
+    remove(testFile.c_str());
+}
+
+TEST(UringReaderTest, EarlyDestroyAndEmptyFile) {
+    std::string testFile = "test_uring_early.csv";
+    writeTestCsv(testFile, 5000);
+    {
+        // Destroying with reads still in flight must not touch freed buffers
+        UringOptions options;
+        options.chunkSize = 4096;
+        UringReader reader(testFile, options);
+        Tick tick;
+        ASSERT_TRUE(reader.next(tick));
+        ASSERT_EQ(tick.timestamp, 1000000);
+    }
+    remove(testFile.c_str());
+    
+    std::string emptyFile = "test_uring_empty.csv";
+    std::ofstream(emptyFile).close();
+    UringReader empty(emptyFile);
+    ASSERT_TRUE(empty.isValid());
+    Tick tick;
+    ASSERT_FALSE(empty.next(tick));
+    remove(emptyFile.c_str());
+    
+    UringReader missing("does_not_exist.csv");
+    ASSERT_FALSE(missing.isValid());
+    ASSERT_FALSE(missing.next(tick));
+}
+
+TEST(UringReaderTest, OpenTickSourceBackends) {
+    std::string csvFile = "test_uring_open.csv";
+    std::string binFile = "test_uring_open.atk";
+    writeTestCsv(csvFile, 100);
+    {
+        TickFileWriter writer(binFile);
+        Tick tick{1000000, 4500.0, 4500.25, 10};
+        writer.write(tick);
+    }
+    
+    std::unique_ptr<TickSource> csv = openTickSource(csvFile, IoBackend::Uring);
+    ASSERT_NE(dynamic_cast<UringReader*>(csv.get()), nullptr);
+    ASSERT_EQ(readAllTicks(*csv).size(), 100u);
+    
+    // Binary formats stay on the mapped reader
+    std::unique_ptr<TickSource> bin = openTickSource(binFile, IoBackend::Uring);
+    ASSERT_NE(dynamic_cast<MarketDataReader*>(bin.get()), nullptr);
+    ASSERT_EQ(readAllTicks(*bin).size(), 1u);
+    
+    remove(csvFile.c_str());
+    remove(binFile.c_str());
+}